@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/multi_draw.hpp>
+
+namespace glh {
+
+// first-fit sub-allocator over [0, capacity), measured in elements
+class range_allocator {
+public:
+    static constexpr GLsizei npos = -1;
+
+    explicit range_allocator(GLsizei capacity = 0);
+
+    // returns the offset of the new range or npos if nothing fits
+    GLsizei allocate(GLsizei size);
+    void free(GLsizei offset, GLsizei size);
+
+    // makes the allocator aware of more space at the end
+    void grow(GLsizei capacity);
+    // forgets every allocation and marks [0, used) as taken
+    void reset(GLsizei used);
+
+    GLsizei capacity() const { return _capacity; }
+    GLsizei available() const;
+
+private:
+    struct range {
+        GLsizei offset;
+        GLsizei size;
+    };
+
+    // free ranges sorted by offset, never adjacent to each other
+    std::vector<range> _free;
+    GLsizei _capacity;
+};
+
+// a single VAO/VBO/EBO shared by many shapes
+//
+// shapes are uploaded into sub-ranges of the buffers and drawn with glDrawElementsBaseVertex,
+// so a whole scene is drawn with one VAO bound. handles stay valid across grow and compact.
+template <typename... Attributes>
+class basic_arena {
+public:
+    using layout = vertex_layout<Attributes...>;
+    using value_type = typename layout::value_type;
+    using shape_type = basic_shape<Attributes...>;
+    using handle = GLuint;
+
+    struct allocation {
+        GLint base_vertex;
+        GLuint first_index;
+        GLsizei vertex_count;
+        GLsizei index_count;
+        bool live;
+    };
+
+    explicit basic_arena(GLsizei vertex_capacity = 1 << 14, GLsizei index_capacity = 1 << 16)
+        : _vertices(vertex_capacity), _indices(index_capacity) {
+        glGenVertexArrays(1, &_vao);
+        _vbo = create_buffer(vertex_capacity * layout::stride);
+        _ebo = create_buffer(index_capacity * sizeof(GLuint));
+        attach();
+    }
+
+    basic_arena(const basic_arena&) = delete;
+    basic_arena& operator=(const basic_arena&) = delete;
+
+    ~basic_arena() {
+        state().delete_vertex_arrays(1, &_vao);
+        state().delete_buffers(1, &_vbo);
+        state().delete_buffers(1, &_ebo);
+    }
+
+    // copies the baked shape into the shared buffers
+    handle allocate(const shape_type& shape) {
+        if (!shapes::is_baked(shape)) {
+            return allocate(shapes::baked(shape));
+        }
+
+        GLsizei vertex_count = shape.vertices.size() / layout::components;
+        GLsizei index_count = shape.indices.size();
+
+        GLsizei base_vertex = reserve(_vertices, _vbo, vertex_count, layout::stride);
+        GLsizei first_index = reserve(_indices, _ebo, index_count, sizeof(GLuint));
+
+        // uploads go through the copy target so no VAO state is touched
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, _vbo);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, base_vertex * layout::stride, vertex_count * layout::stride,
+                        shape.vertices.data());
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, _ebo);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, first_index * sizeof(GLuint), index_count * sizeof(GLuint),
+                        shape.indices.data());
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+
+        allocation entry{base_vertex, (GLuint) first_index, vertex_count, index_count, true};
+        if (!_released.empty()) {
+            handle h = _released.back();
+            _released.pop_back();
+            _allocations[h] = entry;
+            return h;
+        }
+
+        _allocations.push_back(entry);
+        return _allocations.size() - 1;
+    }
+
+    // releases the shape's ranges, the handle may be handed out again
+    void free(handle h) {
+        allocation& entry = _allocations[h];
+        if (!entry.live) return;
+
+        _vertices.free(entry.base_vertex, entry.vertex_count);
+        _indices.free(entry.first_index, entry.index_count);
+
+        entry.live = false;
+        _released.push_back(h);
+    }
+
+    // moves every live shape to the front of the buffers, removing holes left by free
+    void compact() {
+        GLuint vbo = create_buffer(_vertices.capacity() * layout::stride);
+        GLuint ebo = create_buffer(_indices.capacity() * sizeof(GLuint));
+
+        state().bind_buffer(GL_COPY_READ_BUFFER, _vbo);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, vbo);
+
+        GLsizei vertex_end = 0;
+        for (allocation& entry : _allocations) {
+            if (!entry.live) continue;
+
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, entry.base_vertex * layout::stride,
+                                vertex_end * layout::stride, entry.vertex_count * layout::stride);
+            entry.base_vertex = vertex_end;
+            vertex_end += entry.vertex_count;
+        }
+
+        state().bind_buffer(GL_COPY_READ_BUFFER, _ebo);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, ebo);
+
+        // indices are relative to base_vertex, so they move verbatim
+        GLsizei index_end = 0;
+        for (allocation& entry : _allocations) {
+            if (!entry.live) continue;
+
+            glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, entry.first_index * sizeof(GLuint),
+                                index_end * sizeof(GLuint), entry.index_count * sizeof(GLuint));
+            entry.first_index = index_end;
+            index_end += entry.index_count;
+        }
+
+        state().bind_buffer(GL_COPY_READ_BUFFER, 0);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+
+        state().delete_buffers(1, &_vbo);
+        state().delete_buffers(1, &_ebo);
+        _vbo = vbo;
+        _ebo = ebo;
+        attach();
+
+        _vertices.reset(vertex_end);
+        _indices.reset(index_end);
+    }
+
+    void bind() const {
+        state().bind_vertex_array(_vao);
+    }
+
+    // binds the arena's VAO, through state() this costs nothing when it already is
+    void draw(handle h, GLenum mode = GL_TRIANGLES) const {
+        bind();
+        const allocation& entry = _allocations[h];
+        glDrawElementsBaseVertex(mode, entry.index_count, GL_UNSIGNED_INT,
+                                 (GLvoid*) (std::uintptr_t) (entry.first_index * sizeof(GLuint)), entry.base_vertex);
+    }
+
+    // draws every shape with a single call, binding the arena's VAO like the overload above
+    void draw(std::span<const handle> handles, GLenum mode = GL_TRIANGLES) {
+        bind();
+        _batch.clear();
+        for (handle h : handles) {
+            const allocation& entry = _allocations[h];
+            _batch.add(entry.index_count, entry.first_index, entry.base_vertex);
+        }
+        _batch.draw(mode, GL_UNSIGNED_INT);
+    }
+
+    const allocation& operator[](handle h) const {
+        return _allocations[h];
+    }
+
+    GLuint vao() const { return _vao; }
+    GLuint vbo() const { return _vbo; }
+    GLuint ebo() const { return _ebo; }
+
+    GLsizei vertex_capacity() const { return _vertices.capacity(); }
+    GLsizei index_capacity() const { return _indices.capacity(); }
+
+    // fraction of free vertex space that is not at the end of the buffer
+    GLfloat fragmentation() const {
+        GLsizei end = 0;
+        for (const allocation& entry : _allocations) {
+            if (entry.live) end = std::max(end, entry.base_vertex + entry.vertex_count);
+        }
+
+        GLsizei available = _vertices.available();
+        GLsizei tail = _vertices.capacity() - end;
+        return available == 0 ? 0.0f : (GLfloat) (available - tail) / available;
+    }
+
+private:
+    static GLuint create_buffer(GLsizeiptr size) {
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, size, NULL, GL_STATIC_DRAW);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+        return buffer;
+    }
+
+    // points the VAO at the current buffers
+    void attach() {
+        state().bind_vertex_array(_vao);
+        state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+        layout::enable();
+        state().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+        state().bind_vertex_array(0);
+        state().bind_buffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // takes count elements from the allocator, doubling the buffer until they fit
+    GLsizei reserve(range_allocator& allocator, GLuint& buffer, GLsizei count, GLsizei element_size) {
+        GLsizei offset = allocator.allocate(count);
+        if (offset != range_allocator::npos) return offset;
+
+        GLsizei capacity = std::max(allocator.capacity(), 1);
+        while (capacity - allocator.capacity() < count) {
+            capacity *= 2;
+        }
+
+        GLuint grown = create_buffer((GLsizeiptr) capacity * element_size);
+        state().bind_buffer(GL_COPY_READ_BUFFER, buffer);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, grown);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0,
+                            (GLsizeiptr) allocator.capacity() * element_size);
+        state().bind_buffer(GL_COPY_READ_BUFFER, 0);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+
+        state().delete_buffers(1, &buffer);
+        buffer = grown;
+        attach();
+
+        allocator.grow(capacity);
+        return allocator.allocate(count);
+    }
+
+    GLuint _vao;
+    GLuint _vbo;
+    GLuint _ebo;
+
+    range_allocator _vertices;
+    range_allocator _indices;
+
+    std::vector<allocation> _allocations;
+    std::vector<handle> _released;
+
+    multi_draw _batch;
+};
+
+using arena = basic_arena<attributes::vec2>;
+
+}
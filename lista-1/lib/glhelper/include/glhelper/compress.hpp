@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+// IEEE 754 binary16, a distinct type from GLushort so attributes know to use GL_HALF_FLOAT
+struct half {
+    GLushort bits;
+};
+
+template <> inline constexpr GLenum gl_type<half> = GL_HALF_FLOAT;
+
+// rounds to nearest even, out of range values become infinities
+half to_half(GLfloat value);
+GLfloat from_half(half value);
+
+namespace attributes {
+
+using half2 = attribute<half, 2>;
+using unorm16x2 = attribute<GLushort, 2, GL_TRUE>;
+using rgba8 = attribute<GLubyte, 4, GL_TRUE>;
+
+}
+
+enum class position_encoding {
+    // offsets from the bounding box center, 11 bits of precision
+    half_float,
+    // fractions of the bounding box, 1/65535 of its size
+    unorm16
+};
+
+// a mesh whose positions must be multiplied by decode in the vertex shader,
+// e.g. by uploading it to glh::shader::transform_vertex's or transform_vertex_color's transform
+struct compressed_mesh : mesh {
+    glm::mat3 decode;
+};
+
+template <position_encoding Encoding>
+using position_attribute = std::conditional_t<Encoding == position_encoding::half_float,
+                                              attributes::half2, attributes::unorm16x2>;
+
+// every attribute after the position is packed as a color
+template <typename Attribute>
+using packed_color = attributes::rgba8;
+
+template <position_encoding Encoding, typename Position, typename... Rest>
+struct compressed_layout {
+    static_assert(std::is_same_v<typename Position::value_type, GLfloat> && Position::size == 2,
+                  "compression expects vertices starting with a float xy position");
+    static_assert((std::is_same_v<typename Rest::value_type, GLfloat> && ...), "colors must be floats");
+
+    using type = vertex_layout<position_attribute<Encoding>, packed_color<Rest>...>;
+
+    static constexpr GLint color_sizes[sizeof...(Rest) + 1] = {Rest::size..., 0};
+    static constexpr std::size_t color_count = sizeof...(Rest);
+};
+
+// packs vertices made of an xy position followed by float attributes of the given sizes,
+// positions are quantized and the other attributes become RGBA8 (opaque if they have 3 components).
+// the returned matrix maps quantized positions back to the original ones
+glm::mat3 compress_vertices(std::span<const GLfloat> vertices, std::span<const GLint> attribute_sizes,
+                            position_encoding encoding, std::vector<GLubyte>& out);
+
+// like create_mesh, but positions take 4 bytes and every other attribute is packed to RGBA8
+//
+//     glh::compressed_mesh mesh = glh::create_compressed_mesh<glh::position_encoding::unorm16>(shape);
+//
+// the pending transform is not baked but folded into decode. shapes without indices get a count
+// of 0 and are drawn with glDrawArrays.
+template <position_encoding Encoding = position_encoding::unorm16, typename... Attributes>
+compressed_mesh create_compressed_mesh(const basic_shape<Attributes...>& shape) {
+    using info = compressed_layout<Encoding, Attributes...>;
+
+    std::vector<GLubyte> packed;
+    std::span<const GLint> sizes(info::color_sizes, info::color_count);
+    glm::mat3 decode = shape.transform * compress_vertices(shape.vertices, sizes, Encoding, packed);
+
+    GLenum type = index_type(shape.indices);
+    std::vector<GLubyte> indices = pack_indices(shape.indices, type);
+
+    // the bytes seen as the layout's values, which are not bytes when there is only a position
+    using value_type = typename info::type::value_type;
+    std::span<const value_type> vertices((const value_type*) packed.data(), packed.size() / sizeof(value_type));
+
+    compressed_mesh result{make_mesh<typename info::type>(vertices, indices, (GLsizei) shape.indices.size(), type)};
+    result.decode = decode;
+    return result;
+}
+
+}
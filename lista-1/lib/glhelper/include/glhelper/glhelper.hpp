@@ -1,23 +1,180 @@
+#pragma once
+
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <iterator>
 #include <numbers>
+#include <span>
 #include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glhelper/kernels.hpp>
+#include <glhelper/resource.hpp>
+#include <glhelper/state.hpp>
+
 namespace glh {
 
+// OpenGL enum for a component type
+template <typename T>
+constexpr GLenum gl_type = 0;
+
+template <> inline constexpr GLenum gl_type<GLbyte>   = GL_BYTE;
+template <> inline constexpr GLenum gl_type<GLubyte>  = GL_UNSIGNED_BYTE;
+template <> inline constexpr GLenum gl_type<GLshort>  = GL_SHORT;
+template <> inline constexpr GLenum gl_type<GLushort> = GL_UNSIGNED_SHORT;
+template <> inline constexpr GLenum gl_type<GLint>    = GL_INT;
+template <> inline constexpr GLenum gl_type<GLuint>   = GL_UNSIGNED_INT;
+template <> inline constexpr GLenum gl_type<GLfloat>  = GL_FLOAT;
+
+// a single vertex attribute: Size components of type T
+template <typename T, GLint Size, GLboolean Normalized = GL_FALSE>
+struct attribute {
+    static_assert(gl_type<T> != 0, "unsupported attribute component type");
+    static_assert(Size >= 1 && Size <= 4, "attributes have between 1 and 4 components");
+
+    using value_type = T;
+
+    static constexpr GLint size = Size;
+    static constexpr GLenum type = gl_type<T>;
+    static constexpr GLboolean normalized = Normalized;
+    static constexpr GLsizei bytes = Size * sizeof(T);
+};
+
+namespace attributes {
+
+using vec2 = attribute<GLfloat, 2>;
+using vec3 = attribute<GLfloat, 3>;
+using vec4 = attribute<GLfloat, 4>;
+
+}
+
+// interleaved vertex layout, attribute i is bound to location i
+//
+// layouts mixing component types (see glh/compress.hpp) are stored as raw bytes
+template <typename... Attributes>
+struct vertex_layout {
+    static_assert(sizeof...(Attributes) > 0, "a vertex needs at least one attribute");
+
+    using first_type = std::tuple_element_t<0, std::tuple<typename Attributes::value_type...>>;
+    static constexpr bool mixed = !(std::is_same_v<first_type, typename Attributes::value_type> && ...);
+    using value_type = std::conditional_t<mixed, GLubyte, first_type>;
+
+    static constexpr GLuint count = sizeof...(Attributes);
+    // components per vertex, only meaningful when not mixed
+    static constexpr GLint components = (Attributes::size + ...);
+    static constexpr GLsizei stride = (Attributes::bytes + ...);
+
+    // byte offset of each attribute inside a vertex
+    static constexpr std::array<GLsizei, count> offsets = [] {
+        std::array<GLsizei, count> result{};
+        std::array<GLsizei, count> bytes{Attributes::bytes...};
+        for (GLuint i = 1; i < count; ++i) {
+            result[i] = result[i - 1] + bytes[i - 1];
+        }
+        return result;
+    }();
+
+    // sets up the attribute pointers of the bound VAO for the bound GL_ARRAY_BUFFER,
+    // a non-zero divisor makes them per-instance attributes
+    static void enable(GLuint first_location = 0, GLuint divisor = 0) {
+        enable(first_location, divisor, std::make_index_sequence<count>{});
+    }
+
+private:
+    template <std::size_t... I>
+    static void enable(GLuint first_location, GLuint divisor, std::index_sequence<I...>) {
+        ((glVertexAttribPointer(first_location + I, Attributes::size, Attributes::type, Attributes::normalized,
+                                stride, (GLvoid*) (std::uintptr_t) offsets[I]),
+          glEnableVertexAttribArray(first_location + I),
+          glVertexAttribDivisor(first_location + I, divisor)), ...);
+    }
+};
+
 // helper struct
-struct shape {
-    std::vector<GLfloat> vertices;
+template <typename... Attributes>
+struct basic_shape {
+    using layout = vertex_layout<Attributes...>;
+
+    std::vector<typename layout::value_type> vertices;
     std::vector<GLuint> indices;
+
+    // pending transform, vertices are only rewritten when the shape is baked
+    glm::mat3 transform{1.0f};
 };
 
+using shape = basic_shape<attributes::vec2>;
+using color_shape = basic_shape<attributes::vec2, attributes::vec3>;
+
+inline glm::mat3 to_mat3(const affine& m) {
+    return glm::mat3(glm::vec3(m.a, m.d, 0.0f), glm::vec3(m.b, m.e, 0.0f), glm::vec3(m.c, m.f, 1.0f));
+}
+
+inline affine to_affine(const glm::mat3& m) {
+    return {m[0][0], m[1][0], m[2][0], m[0][1], m[1][1], m[2][1]};
+}
+
+namespace shapes {
+
+template <typename... Attributes>
+constexpr bool is_baked(const basic_shape<Attributes...>& shape) {
+    return shape.transform == glm::mat3(1.0f);
+}
+
+// applies m to the positions (the first two components) of count vertices
+template <typename Layout>
+constexpr void transform_positions(typename Layout::value_type* vertices, std::size_t count, const affine& m) {
+    if constexpr (std::is_same_v<typename Layout::value_type, GLfloat>) {
+        if (!std::is_constant_evaluated()) {
+            return kernels::transform(vertices, count, Layout::components, m);
+        }
+    }
+
+    for (std::size_t i = 0; i < count; ++i, vertices += Layout::components) {
+        GLfloat x = vertices[0];
+        GLfloat y = vertices[1];
+
+        vertices[0] = m.a * x + m.b * y + m.c;
+        vertices[1] = m.d * x + m.e * y + m.f;
+    }
+}
+
+// applies the pending transform to the vertices
+template <typename... Attributes>
+constexpr void bake(basic_shape<Attributes...>& shape) {
+    using layout = typename basic_shape<Attributes...>::layout;
+
+    if (is_baked(shape)) return;
+
+    transform_positions<layout>(shape.vertices.data(), shape.vertices.size() / layout::components,
+                                to_affine(shape.transform));
+    shape.transform = glm::mat3(1.0f);
+}
+
+template <typename... Attributes>
+constexpr basic_shape<Attributes...> baked(basic_shape<Attributes...> shape) {
+    bake(shape);
+    return shape;
+}
+
+// bakes many shapes with a single kernel dispatch
+void bake(std::span<shape> shapes);
+
+}
+
 // constants
 const GLint DEFAULT_WIDTH = 1280;
 const GLint DEFAULT_HEIGHT = 720;
@@ -36,9 +193,146 @@ GLFWwindow* create_window(std::string title, GLint width = DEFAULT_WIDTH, GLint
 GLuint compile_shader(const GLchar* const* shader_source, GLenum type);
 GLuint create_shader_program(std::initializer_list<GLuint> shaders, bool delete_shaders = true);
 
+// a VAO and what is needed to draw it, the VAO and its buffers are released with the mesh
+struct mesh {
+    vao_handle vao;
+    GLsizei count;
+    // GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT or GL_UNSIGNED_INT
+    GLenum index_type;
+    // the buffers the VAO reads from go back to names() along with it,
+    // ebo is empty when the index buffer is shared (see index_cache)
+    buffer_handle vbo;
+    buffer_handle ebo;
+};
+
+// narrowest index type able to address every index
+GLenum index_type(std::span<const GLuint> indices);
+GLsizei index_size(GLenum index_type);
+// copies indices into a tightly packed buffer of the given type
+std::vector<GLubyte> pack_indices(std::span<const GLuint> indices, GLenum index_type);
+
+// uploads indices into a new GL_ELEMENT_ARRAY_BUFFER from names() without touching the bound VAO
+GLuint create_index_buffer(const GLvoid* indices, GLsizeiptr indices_size);
+
+// uploads vertices into a new GL_ARRAY_BUFFER from names()
+template <typename Layout>
+GLuint create_vertex_buffer(std::span<const typename Layout::value_type> vertices) {
+    GLuint vbo = names().acquire(object_kind::buffer);
+    state().bind_buffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(typename Layout::value_type), vertices.data(), GL_STATIC_DRAW);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+    return vbo;
+}
+
+// builds a VAO from names() over existing buffers, ebo may be 0. the buffers stay the caller's
+template <typename Layout>
+GLuint create_vao_over(GLuint vbo, GLuint ebo) {
+    GLuint vao = names().acquire(object_kind::vertex_array);
+    state().bind_vertex_array(vao);
+
+    state().bind_buffer(GL_ARRAY_BUFFER, vbo);
+    Layout::enable();
+
+    if (ebo != 0) {
+        state().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    }
+
+    state().bind_vertex_array(0);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+    if (ebo != 0) {
+        state().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    return vao;
+}
+
+// builds a VAO from names() over a new vertex buffer and an existing index buffer, ebo may be 0.
+// the vertex buffer's name is retired at once, so releasing the VAO also frees the vertices.
+// meshes keep their buffers instead, so the names are recycled
+template <typename Layout>
+GLuint create_vao(std::span<const typename Layout::value_type> vertices, GLuint ebo) {
+    GLuint vbo = create_vertex_buffer<Layout>(vertices);
+    GLuint vao = create_vao_over<Layout>(vbo, ebo);
+    names().retire(object_kind::buffer, vbo);
+    return vao;
+}
+
+// the index buffer belongs to the VAO like the vertex buffer
+template <typename Layout>
+GLuint create_vao(std::span<const typename Layout::value_type> vertices, const GLvoid* indices, GLsizeiptr indices_size) {
+    if (indices_size == 0) {
+        return create_vao<Layout>(vertices, 0);
+    }
+
+    GLuint ebo = create_index_buffer(indices, indices_size);
+    GLuint vao = create_vao<Layout>(vertices, ebo);
+    names().retire(object_kind::buffer, ebo);
+    return vao;
+}
+
+template <typename Layout>
+GLuint create_vao(std::span<const typename Layout::value_type> vertices, std::span<const GLuint> indices) {
+    return create_vao<Layout>(vertices, indices.data(), indices.size() * sizeof(GLuint));
+}
+
+// uploads the baked vertices unless bake is false,
+// then the pending transform is expected to be sent as a uniform (see set_transform)
+template <typename... Attributes>
+GLuint create_vao(const basic_shape<Attributes...>& shape, bool bake = true) {
+    if (bake && !shapes::is_baked(shape)) {
+        return create_vao(shapes::baked(shape), false);
+    }
+
+    return create_vao<vertex_layout<Attributes...>>(shape.vertices, shape.indices);
+}
+
+// a mesh over a new vertex buffer and the indices, packed as index_type, in a new index buffer
+template <typename Layout>
+mesh make_mesh(std::span<const typename Layout::value_type> vertices, std::span<const GLubyte> indices,
+               GLsizei count, GLenum index_type) {
+    mesh result{vao_handle(), count, index_type};
+    result.vbo = buffer_handle(create_vertex_buffer<Layout>(vertices));
+    if (!indices.empty()) {
+        result.ebo = buffer_handle(create_index_buffer(indices.data(), indices.size()));
+    }
+    result.vao = vao_handle(create_vao_over<Layout>(result.vbo, result.ebo));
+    return result;
+}
+
+// like make_mesh, but over a shared index buffer the mesh does not own
+template <typename Layout>
+mesh make_mesh(std::span<const typename Layout::value_type> vertices, GLuint shared_ebo,
+               GLsizei count, GLenum index_type) {
+    mesh result{vao_handle(), count, index_type};
+    result.vbo = buffer_handle(create_vertex_buffer<Layout>(vertices));
+    result.vao = vao_handle(create_vao_over<Layout>(result.vbo, shared_ebo));
+    return result;
+}
+
+// like create_vao, but stores indices in the narrowest type that fits
+template <typename... Attributes>
+mesh create_mesh(const basic_shape<Attributes...>& shape, bool bake = true) {
+    if (bake && !shapes::is_baked(shape)) {
+        return create_mesh(shapes::baked(shape), false);
+    }
+
+    GLenum type = index_type(shape.indices);
+    std::vector<GLubyte> packed = pack_indices(shape.indices, type);
+
+    return make_mesh<vertex_layout<Attributes...>>(shape.vertices, packed, (GLsizei) shape.indices.size(), type);
+}
+
+// binds the mesh's VAO and draws all of its indices
+void draw(const mesh& mesh, GLenum mode = GL_TRIANGLES);
+
+// uploads a shape's pending transform to a mat3 uniform of the current program
+template <typename... Attributes>
+void set_transform(GLint location, const basic_shape<Attributes...>& shape) {
+    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(shape.transform));
+}
+
 GLuint create_vao(const std::vector<GLfloat>& vertices, const std::vector<GLuint>& indices);
-GLuint create_vao(std::vector<GLfloat>& vertices);
-GLuint create_vao(shape& shape);
+GLuint create_vao(const std::vector<GLfloat>& vertices);
 
 // shape functions
 namespace shapes {
@@ -108,7 +402,7 @@ constexpr shape make_star(GLfloat radius, GLuint points, GLfloat x = 0, GLfloat
 
         star_indices[i * 3]     = i % points;
         star_indices[i * 3 + 1] = (i + 1) % points;
-        star_indices[i * 3 + 2] = points * 2 + 1;
+        star_indices[i * 3 + 2] = points;
     }
 
     *(star_vertices.rbegin() + 1) = x;
@@ -137,50 +431,292 @@ constexpr std::vector<GLfloat> make_spiral(GLfloat radius, GLuint loops, GLfloat
     return vertices;
 }
 
-constexpr void translate(shape& shape, GLfloat delta_x, GLfloat delta_y) {
-    std::vector<GLfloat>& v = shape.vertices;
-    for (auto it = v.begin(), it2 = v.begin() + 1; it != v.end(); it += 2, it2 += 2) {
-        *it += delta_x;
-        *it2 += delta_y;
+// pie slice from start to start + sweep (in degrees, counterclockwise) as a fan around the center,
+// the center is the last vertex like in make_polygon
+constexpr shape make_sector(GLfloat radius, GLfloat start, GLfloat sweep, GLuint segments,
+                            GLfloat x = 0, GLfloat y = 0) {
+    GLfloat angle = start * std::numbers::pi / 180.0f;
+    GLfloat slice = sweep * std::numbers::pi / 180.0f / segments;
+
+    std::vector<GLfloat> vertices(segments * 2 + 4);
+    std::vector<GLuint> indices(segments * 3);
+
+    for (GLuint i = 0; i <= segments; ++i, angle += slice) {
+        vertices[2 * i]     = radius * std::cos(angle) + x;
+        vertices[2 * i + 1] = radius * std::sin(angle) + y;
+    }
+
+    for (GLuint i = 0; i < segments; ++i) {
+        indices[i * 3]     = i;
+        indices[i * 3 + 1] = i + 1;
+        indices[i * 3 + 2] = segments + 1;
     }
+
+    *(vertices.rbegin() + 1) = x;
+    *vertices.rbegin() = y;
+
+    return {vertices, indices};
 }
 
-constexpr void rotate(shape& shape, GLfloat angle, GLfloat center_x, GLfloat center_y) {
-    angle = angle * std::numbers::pi / 180.0f;
-    GLfloat cos = std::cos(angle);
-    GLfloat sin = std::sin(angle);
+// points along a circle from start to start + sweep (in degrees), drawn as GL_LINE_STRIP
+constexpr std::vector<GLfloat> make_arc(GLfloat radius, GLfloat start, GLfloat sweep, GLuint segments,
+                                        GLfloat x = 0, GLfloat y = 0) {
+    GLfloat angle = start * std::numbers::pi / 180.0f;
+    GLfloat slice = sweep * std::numbers::pi / 180.0f / segments;
 
-    // auto end = shape.vertices.begin() + shape.vertices.size() - 2;
-    for (auto it = shape.vertices.begin(); it != shape.vertices.end(); it += 2) {
-        GLfloat x = *it - center_x;
-        GLfloat y = *(it + 1) - center_y;
+    std::vector<GLfloat> vertices(segments * 2 + 2);
 
-        *it = x * cos - y * sin + center_x;
-        *(it + 1) = y * cos + x * sin + center_y;
+    for (GLuint i = 0; i <= segments; ++i, angle += slice) {
+        vertices[2 * i]     = radius * std::cos(angle) + x;
+        vertices[2 * i + 1] = radius * std::sin(angle) + y;
     }
+
+    return vertices;
 }
 
-constexpr void rotate(shape& shape, GLfloat angle) {
-    return rotate(shape, angle, *(shape.vertices.rbegin() + 1), shape.vertices.back());
+// band between two radii from start to start + sweep (in degrees),
+// vertices alternate outer and inner and each segment is a quad of two triangles
+constexpr shape make_ring(GLfloat inner_radius, GLfloat outer_radius, GLfloat start, GLfloat sweep, GLuint segments,
+                          GLfloat x = 0, GLfloat y = 0) {
+    GLfloat angle = start * std::numbers::pi / 180.0f;
+    GLfloat slice = sweep * std::numbers::pi / 180.0f / segments;
+
+    std::vector<GLfloat> vertices(segments * 4 + 4);
+    std::vector<GLuint> indices(segments * 6);
+
+    for (GLuint i = 0; i <= segments; ++i, angle += slice) {
+        GLfloat cos = std::cos(angle);
+        GLfloat sin = std::sin(angle);
+
+        vertices[4 * i]     = outer_radius * cos + x;
+        vertices[4 * i + 1] = outer_radius * sin + y;
+        vertices[4 * i + 2] = inner_radius * cos + x;
+        vertices[4 * i + 3] = inner_radius * sin + y;
+    }
+
+    for (GLuint i = 0; i < segments; ++i) {
+        GLuint outer = 2 * i;
+        GLuint inner = 2 * i + 1;
+
+        indices[i * 6]     = outer;
+        indices[i * 6 + 1] = outer + 2;
+        indices[i * 6 + 2] = inner;
+        indices[i * 6 + 3] = inner;
+        indices[i * 6 + 4] = outer + 2;
+        indices[i * 6 + 5] = inner + 2;
+    }
+
+    return {vertices, indices};
 }
 
-constexpr shape group(std::initializer_list<std::reference_wrapper<shape>> shapes) {
-    shape result {shapes.begin()->get().vertices, shapes.begin()->get().indices};
-    
-    GLuint offset = shapes.begin()->get().vertices.size() / 2;
-    for (auto it = shapes.begin() + 1; it != shapes.end(); ++it) {
-        std::for_each(it->get().indices.begin(), it->get().indices.end(), [offset](GLuint& idx) {
-            idx += offset;
-        });
-        offset += it->get().vertices.size() / 2;
+// triangulates a simple polygon given as xy pairs, holes are polygons strictly inside it,
+// either winding is accepted. vertices are the outline followed by the holes, in input order.
+// runs in O(n log n) by splitting the polygon into y-monotone pieces
+shape triangulate(std::span<const GLfloat> outline, std::span<const std::vector<GLfloat>> holes = {});
+
+// transforms are accumulated into the shape's pending matrix and cost O(1),
+// they act on the vertices as they will be after baking
+template <typename... Attributes>
+constexpr void transform(basic_shape<Attributes...>& shape, const glm::mat3& m) {
+    shape.transform = m * shape.transform;
+}
+
+template <typename... Attributes>
+constexpr void transform(basic_shape<Attributes...>& shape, const affine& m) {
+    transform(shape, to_mat3(m));
+}
+
+void transform(std::initializer_list<std::reference_wrapper<shape>> shapes, const affine& m);
+
+template <typename... Attributes>
+constexpr void translate(basic_shape<Attributes...>& shape, GLfloat delta_x, GLfloat delta_y) {
+    transform(shape, affines::translation(delta_x, delta_y));
+}
+
+template <typename... Attributes>
+constexpr void rotate(basic_shape<Attributes...>& shape, GLfloat angle, GLfloat center_x, GLfloat center_y) {
+    transform(shape, affines::rotation(angle, center_x, center_y));
+}
+
+// rotates around the last vertex, which is the center of polygons and stars
+template <typename... Attributes>
+constexpr void rotate(basic_shape<Attributes...>& shape, GLfloat angle) {
+    constexpr GLint step = basic_shape<Attributes...>::layout::components;
+
+    auto last = shape.vertices.end() - step;
+    glm::vec3 center = shape.transform * glm::vec3(*last, *(last + 1), 1.0f);
+    rotate(shape, angle, center.x, center.y);
+}
 
-        result.vertices.insert(result.vertices.end(), it->get().vertices.begin(), it->get().vertices.end());
-        result.indices.insert(result.indices.end(), it->get().indices.begin(), it->get().indices.end());
+// appends src to the baked shape dst, rebasing its indices and applying its pending transform
+template <typename... Attributes>
+constexpr void append(basic_shape<Attributes...>& dst, const basic_shape<Attributes...>& src) {
+    using layout = typename basic_shape<Attributes...>::layout;
+
+    std::size_t first_vertex = dst.vertices.size();
+    std::size_t first_index = dst.indices.size();
+    GLuint offset = first_vertex / layout::components;
+
+    dst.vertices.insert(dst.vertices.end(), src.vertices.begin(), src.vertices.end());
+    if (!is_baked(src)) {
+        transform_positions<layout>(dst.vertices.data() + first_vertex, src.vertices.size() / layout::components,
+                                    to_affine(src.transform));
     }
 
+    dst.indices.resize(first_index + src.indices.size());
+    std::transform(src.indices.begin(), src.indices.end(), dst.indices.begin() + first_index, [offset](GLuint idx) {
+        return idx + offset;
+    });
+}
+
+// concatenates shapes into one, the inputs are left untouched
+constexpr shape group(std::initializer_list<std::reference_wrapper<const shape>> shapes) {
+    std::size_t vertex_count = 0;
+    std::size_t index_count = 0;
+    for (const shape& s : shapes) {
+        vertex_count += s.vertices.size();
+        index_count += s.indices.size();
+    }
+
+    shape result;
+    result.vertices.reserve(vertex_count);
+    result.indices.reserve(index_count);
+    for (const shape& s : shapes) {
+        append(result, s);
+    }
+
+    return result;
+}
+
+template <typename T>
+constexpr bool is_shape = false;
+
+template <typename... Attributes>
+constexpr bool is_shape<basic_shape<Attributes...>> = true;
+
+// like group, for any layout; when the first shape is an rvalue its buffers are reused
+template <typename First, typename... Rest>
+    requires is_shape<std::remove_cvref_t<First>> && (std::is_same_v<std::remove_cvref_t<First>, std::remove_cvref_t<Rest>> && ...)
+constexpr std::remove_cvref_t<First> group(First&& first, Rest&&... rest) {
+    std::size_t vertex_count = first.vertices.size() + (rest.vertices.size() + ... + 0);
+    std::size_t index_count = first.indices.size() + (rest.indices.size() + ... + 0);
+
+    std::remove_cvref_t<First> result;
+    if constexpr (std::is_lvalue_reference_v<First>) {
+        result.vertices.reserve(vertex_count);
+        result.indices.reserve(index_count);
+        append(result, first);
+    } else {
+        result = std::move(first);
+        bake(result);
+        result.vertices.reserve(vertex_count);
+        result.indices.reserve(index_count);
+    }
+
+    (append(result, rest), ...);
     return result;
 }
 
+// builds a shape from primitives appended straight into reserved storage
+template <typename... Attributes>
+class basic_shape_builder {
+public:
+    using shape_type = basic_shape<Attributes...>;
+    using layout = typename shape_type::layout;
+    using value_type = typename layout::value_type;
+
+    // components after the position, e.g. the color of a color_shape
+    using extra_type = std::array<value_type, layout::components - 2>;
+
+    constexpr basic_shape_builder() = default;
+
+    constexpr basic_shape_builder(std::size_t vertex_count, std::size_t index_count) {
+        reserve(vertex_count, index_count);
+    }
+
+    constexpr void reserve(std::size_t vertex_count, std::size_t index_count) {
+        _shape.vertices.reserve(vertex_count * layout::components);
+        _shape.indices.reserve(index_count);
+    }
+
+    constexpr basic_shape_builder& add(const shape_type& shape) {
+        append(_shape, shape);
+        return *this;
+    }
+
+    // axis-aligned rectangle with its bottom left corner at (x, y), same topology as make_rectangle
+    constexpr basic_shape_builder& add_rectangle(GLfloat x, GLfloat y, GLfloat width, GLfloat height,
+                                                 const extra_type& extra = {}) {
+        GLuint first = vertex_count();
+
+        add_vertex(x, y, extra);
+        add_vertex(x, y + height, extra);
+        add_vertex(x + width, y + height, extra);
+        add_vertex(x + width, y, extra);
+
+        for (GLuint idx : {0, 1, 3, 1, 2, 3}) {
+            _shape.indices.push_back(first + idx);
+        }
+
+        return *this;
+    }
+
+    constexpr basic_shape_builder& add_triangle(GLfloat x0, GLfloat y0, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2,
+                                                const extra_type& extra = {}) {
+        GLuint first = vertex_count();
+
+        add_vertex(x0, y0, extra);
+        add_vertex(x1, y1, extra);
+        add_vertex(x2, y2, extra);
+
+        _shape.indices.insert(_shape.indices.end(), {first, first + 1, first + 2});
+        return *this;
+    }
+
+    // regular polygon as a center fan, same topology as make_polygon
+    constexpr basic_shape_builder& add_polygon(GLfloat radius, GLuint sides, GLfloat x = 0, GLfloat y = 0,
+                                               const extra_type& extra = {}) {
+        GLuint first = vertex_count();
+        GLfloat slice = 2 * std::numbers::pi / sides;
+
+        for (GLuint i = 0; i < sides; ++i) {
+            add_vertex(radius * std::cos(i * slice) + x, radius * std::sin(i * slice) + y, extra);
+
+            _shape.indices.push_back(first + i);
+            _shape.indices.push_back(first + (i + 1) % sides);
+            _shape.indices.push_back(first + sides);
+        }
+        add_vertex(x, y, extra);
+
+        return *this;
+    }
+
+    constexpr GLuint vertex_count() const {
+        return _shape.vertices.size() / layout::components;
+    }
+
+    constexpr const shape_type& shape() const {
+        return _shape;
+    }
+
+    // moves the result out, the builder is left empty
+    constexpr shape_type build() {
+        return std::exchange(_shape, {});
+    }
+
+private:
+    constexpr void add_vertex(GLfloat x, GLfloat y, const extra_type& extra) {
+        _shape.vertices.push_back(x);
+        _shape.vertices.push_back(y);
+        _shape.vertices.insert(_shape.vertices.end(), extra.begin(), extra.end());
+    }
+
+    shape_type _shape;
+};
+
+using shape_builder = basic_shape_builder<attributes::vec2>;
+using color_shape_builder = basic_shape_builder<attributes::vec2, attributes::vec3>;
+
 }
 
 // shader sources
@@ -244,6 +780,393 @@ const GLchar* const basic_fragment_uniform = R"(
     }
 )";
 
+// per-instance 2x3 transform and color, see glh::basic_instanced_mesh.
+// the camera comes from glh::frame_uniforms
+const GLchar* const instanced_vertex = R"(
+    #version 330 core
+
+    layout (location = 0) in vec2 pos;
+    layout (location = 1) in vec3 transform_x;
+    layout (location = 2) in vec3 transform_y;
+    layout (location = 3) in vec4 color;
+
+    layout (std140) uniform frame {
+        mat4 projection;
+        mat4 view;
+        float time;
+    };
+
+    out vec4 vertex_color;
+
+    void main() {
+        vec3 p = vec3(pos, 1.0f);
+        gl_Position = projection * view * vec4(dot(transform_x, p), dot(transform_y, p), 0.0f, 1.0f);
+        vertex_color = color;
+    }
+)";
+
+const GLchar* const instanced_fragment = R"(
+    #version 330 core
+
+    in vec4 vertex_color;
+
+    out vec4 color;
+
+    void main() {
+        color = vertex_color;
+    }
+)";
+
+// applies a shape's pending transform on the GPU, see glh::set_transform
+const GLchar* const transform_vertex = R"(
+    #version 330 core
+
+    layout (location = 0) in vec2 pos;
+
+    uniform mat3 transform;
+
+    void main() {
+        gl_Position = vec4((transform * vec3(pos, 1.0f)).xy, 0.0f, 1.0f);
+    }
+)";
+
+// positions go through a mat4, usually a glm::ortho projection
+const GLchar* const projection_vertex = R"(
+    #version 330 core
+
+    layout (location = 0) in vec2 pos;
+
+    uniform mat4 projection;
+
+    void main() {
+        gl_Position = projection * vec4(pos, 0.0f, 1.0f);
+    }
+)";
+
+const GLchar* const transform_vertex_color = R"(
+    #version 330 core
+
+    layout (location = 0) in vec2 pos;
+    layout (location = 1) in vec3 color;
+
+    uniform mat3 transform;
+
+    out vec3 vertex_color;
+
+    void main() {
+        gl_Position = vec4((transform * vec3(pos, 1.0f)).xy, 0.0f, 1.0f);
+        vertex_color = color;
+    }
+)";
+
+// reads the camera from glh::frame_uniforms
+const GLchar* const frame_vertex = R"(
+    #version 330 core
+
+    layout (location = 0) in vec2 pos;
+
+    layout (std140) uniform frame {
+        mat4 projection;
+        mat4 view;
+        float time;
+    };
+
+    void main() {
+        gl_Position = projection * view * vec4(pos, 0.0f, 1.0f);
+    }
+)";
+
+// reads its color from the material bound by glh::material_ring
+const GLchar* const material_fragment = R"(
+    #version 330 core
+
+    layout (std140) uniform material {
+        vec4 material_color;
+    };
+
+    out vec4 color;
+
+    void main() {
+        color = material_color;
+    }
+)";
+
+// builds polygons, stars and spirals from gl_VertexID, see glh::procedural
+const GLchar* const procedural_vertex = R"(
+    #version 330 core
+
+    const float PI = 3.14159265358979f;
+
+    const int POLYGON = 0;
+    const int STAR = 1;
+    const int SPIRAL = 2;
+
+    const int SPIRAL_SIDES = 64;
+
+    uniform int kind;
+    uniform float radius;
+    uniform int count;
+    uniform vec2 center;
+
+    vec2 polar(float r, float angle) {
+        return center + r * vec2(cos(angle), sin(angle));
+    }
+
+    void main() {
+        vec2 pos;
+
+        if (kind == SPIRAL) {
+            float step = float(gl_VertexID) / float(SPIRAL_SIDES * count);
+            pos = polar(radius * step, 2.0f * PI * float(gl_VertexID) / float(SPIRAL_SIDES));
+        } else {
+            // triangle i of the fan is (rim i, rim i + 1, center)
+            int rim = kind == STAR ? 2 * count : count;
+            int corner = gl_VertexID % 3;
+            int i = (gl_VertexID / 3 + corner) % rim;
+
+            float r = kind == STAR && i % 2 == 1 ? 0.5f * radius : radius;
+            pos = corner == 2 ? center : polar(r, 2.0f * PI * float(i) / float(rim));
+        }
+
+        gl_Position = vec4(pos, 0.0f, 1.0f);
+    }
+)";
+
+// textured quads for glh::sprites::sprite_batch, corners come from gl_VertexID
+const GLchar* const sprite_vertex = R"(
+    #version 330 core
+
+    layout (location = 0) in vec4 rect;
+    layout (location = 1) in vec4 uv_rect;
+
+    out vec2 uv;
+
+    void main() {
+        vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+
+        uv = mix(uv_rect.xy, uv_rect.zw, corner);
+        gl_Position = vec4(rect.xy + corner * rect.zw, 0.0f, 1.0f);
+    }
+)";
+
+const GLchar* const sprite_fragment = R"(
+    #version 330 core
+
+    in vec2 uv;
+
+    out vec4 color;
+
+    uniform sampler2D sprite;
+
+    void main() {
+        color = texture(sprite, uv);
+        if (color.a < 0.5f) {
+            discard;
+        }
+    }
+)";
+
+// one quad per instance of glh::sdf_batch, corners come from gl_VertexID
+const GLchar* const sdf_vertex = R"(
+    #version 330 core
+
+    // center and half extents
+    layout (location = 0) in vec4 bounds;
+    // kind, count, parameter and angle in radians
+    layout (location = 1) in vec4 shape;
+    layout (location = 2) in vec4 shape_color;
+
+    uniform mat4 projection;
+
+    out vec2 local;
+    flat out int kind;
+    flat out vec4 params;
+    out vec4 fill;
+
+    void main() {
+        // a little larger than the shape so the antialiased edge fits
+        vec2 corner = (vec2(gl_VertexID & 1, gl_VertexID >> 1) * 2.0f - 1.0f) * 1.125f;
+        local = corner * bounds.zw;
+
+        float c = cos(shape.w);
+        float s = sin(shape.w);
+        vec2 pos = bounds.xy + mat2(c, s, -s, c) * local;
+
+        kind = int(shape.x);
+        params = vec4(shape.yz, bounds.zw);
+        fill = shape_color;
+
+        gl_Position = projection * vec4(pos, 0.0f, 1.0f);
+    }
+)";
+
+// analytic distance to a circle, rounded rectangle, regular polygon or star, see glh::sdf_batch
+const GLchar* const sdf_fragment = R"(
+    #version 330 core
+
+    const float PI = 3.14159265358979f;
+
+    const int CIRCLE = 0;
+    const int ROUNDED_RECT = 1;
+    const int POLYGON = 2;
+    const int STAR = 3;
+
+    in vec2 local;
+    flat in int kind;
+    // count, parameter and half extents
+    flat in vec4 params;
+    in vec4 fill;
+
+    out vec4 color;
+
+    // spikes alternate between radius and inner, the first one points along +x
+    float star(vec2 p, float radius, float count, float inner) {
+        float slice = PI / count;
+        float angle = abs(mod(atan(p.y, p.x) + slice, 2.0f * slice) - slice);
+        vec2 q = length(p) * vec2(cos(angle), sin(angle));
+
+        vec2 tip = vec2(radius, 0.0f);
+        vec2 edge = inner * vec2(cos(slice), sin(slice)) - tip;
+        vec2 to = q - tip;
+
+        float h = clamp(dot(to, edge) / dot(edge, edge), 0.0f, 1.0f);
+        float d = length(to - edge * h);
+        return edge.x * to.y - edge.y * to.x > 0.0f ? -d : d;
+    }
+
+    void main() {
+        float d;
+        if (kind == CIRCLE) {
+            d = length(local) - params.z;
+        } else if (kind == ROUNDED_RECT) {
+            vec2 q = abs(local) - params.zw + params.y;
+            d = length(max(q, 0.0f)) + min(max(q.x, q.y), 0.0f) - params.y;
+        } else if (kind == POLYGON) {
+            d = star(local, params.z, params.x, params.z * cos(PI / params.x));
+        } else {
+            d = star(local, params.z, params.x, params.z * params.y);
+        }
+
+        // one pixel wide ramp across the edge
+        float alpha = clamp(0.5f - d / max(fwidth(d), 1e-6f), 0.0f, 1.0f);
+        if (alpha <= 0.0f) {
+            discard;
+        }
+
+        color = vec4(fill.rgb, fill.a * alpha);
+    }
+)";
+
+// one quad per segment of glh::polyline, extruded in pixels, corners come from gl_VertexID
+const GLchar* const polyline_vertex = R"(
+    #version 330 core
+
+    const int MITER = 0;
+    const int ROUND = 1;
+
+    // the same buffer read at four consecutive points, the segment goes from a to b
+    layout (location = 0) in vec2 prev;
+    layout (location = 1) in vec2 a;
+    layout (location = 2) in vec2 b;
+    layout (location = 3) in vec2 next;
+
+    uniform mat4 projection;
+    uniform vec2 viewport;
+    uniform float width;
+    uniform int join;
+
+    out vec2 screen;
+    out float across;
+    flat out vec2 start;
+    flat out vec2 end;
+
+    vec2 to_screen(vec2 p) {
+        vec4 clip = projection * vec4(p, 0.0f, 1.0f);
+        return (clip.xy / clip.w * 0.5f + 0.5f) * viewport;
+    }
+
+    void main() {
+        vec2 screen_prev = to_screen(prev);
+        vec2 screen_a = to_screen(a);
+        vec2 screen_b = to_screen(b);
+        vec2 screen_next = to_screen(next);
+
+        // one extra pixel for the antialiased edge
+        float half_width = width * 0.5f + 1.0f;
+        bool at_b = (gl_VertexID & 1) == 1;
+        float side = float(gl_VertexID >> 1) * 2.0f - 1.0f;
+
+        vec2 direction = screen_b - screen_a;
+        direction = length(direction) > 0.0f ? normalize(direction) : vec2(1.0f, 0.0f);
+        vec2 normal = vec2(-direction.y, direction.x);
+
+        vec2 pos;
+        if (join == ROUND) {
+            // caps reach past both ends, the fragment shader rounds them
+            vec2 base = at_b ? screen_b + direction * half_width : screen_a - direction * half_width;
+            pos = base + normal * side * half_width;
+        } else {
+            // both segments meeting at a point move it along the same miter, so they share an edge
+            vec2 point = at_b ? screen_b : screen_a;
+            vec2 neighbor = at_b ? screen_next - screen_b : screen_a - screen_prev;
+
+            vec2 miter = normal;
+            if (length(neighbor) > 0.0f) {
+                vec2 tangent = normalize(neighbor) + direction;
+                if (length(tangent) > 1e-3f) {
+                    tangent = normalize(tangent);
+                    miter = vec2(-tangent.y, tangent.x);
+                }
+            }
+
+            // limits spikes on sharp turns to 4 half widths
+            pos = point + miter * side * half_width / max(dot(miter, normal), 0.25f);
+        }
+
+        screen = pos;
+        across = dot(pos - screen_a, normal);
+        start = screen_a;
+        end = screen_b;
+
+        gl_Position = vec4(pos / viewport * 2.0f - 1.0f, 0.0f, 1.0f);
+    }
+)";
+
+const GLchar* const polyline_fragment = R"(
+    #version 330 core
+
+    const int ROUND = 1;
+
+    in vec2 screen;
+    in float across;
+    flat in vec2 start;
+    flat in vec2 end;
+
+    uniform float width;
+    uniform int join;
+    uniform vec4 line_color;
+
+    out vec4 color;
+
+    void main() {
+        float d = abs(across);
+        if (join == ROUND) {
+            // distance to the segment, which rounds the joins and caps
+            vec2 to = screen - start;
+            vec2 segment = end - start;
+            float h = clamp(dot(to, segment) / max(dot(segment, segment), 1e-6f), 0.0f, 1.0f);
+            d = length(to - segment * h);
+        }
+
+        float alpha = clamp(width * 0.5f - d + 0.5f, 0.0f, 1.0f);
+        if (alpha <= 0.0f) {
+            discard;
+        }
+
+        color = vec4(line_color.rgb, line_color.a * alpha);
+    }
+)";
+
 }
 
 }
\ No newline at end of file
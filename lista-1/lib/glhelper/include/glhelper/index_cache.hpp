@@ -0,0 +1,105 @@
+#pragma once
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+// index patterns produced by the glh::shapes generators
+enum class topology : GLuint {
+    triangle, // make_triangle
+    quad,     // make_rectangle
+    polygon,  // make_polygon with count sides
+    star,     // make_star with count points
+    sector,   // make_sector with count segments
+    ring      // make_ring with count segments
+};
+
+struct topology_key {
+    topology kind;
+    GLuint count = 0;
+
+    auto operator<=>(const topology_key&) const = default;
+};
+
+// hands out one shared index buffer per distinct index list
+//
+// shapes from the same generator with the same count have identical indices, so their VAOs can
+// all point at a single EBO. the cache gives up its buffers when destroyed,
+// each one is then freed along with the last VAO reading from it.
+class index_cache {
+public:
+    struct entry {
+        GLuint ebo;
+        GLsizei count;
+        GLenum type;
+    };
+
+    index_cache() = default;
+
+    index_cache(const index_cache&) = delete;
+    index_cache& operator=(const index_cache&) = delete;
+
+    ~index_cache();
+
+    // the buffer for key, indices are only read (and uploaded) the first time the key is seen
+    entry acquire(topology_key key, std::span<const GLuint> indices);
+    // the buffer holding exactly these indices, found by hashing them
+    entry acquire(std::span<const GLuint> indices);
+
+    // number of distinct buffers
+    std::size_t size() const { return _entries.size(); }
+    // bytes of index data uploaded
+    GLsizeiptr bytes() const { return _bytes; }
+    // acquires answered without an upload
+    std::size_t hits() const { return _hits; }
+
+private:
+    // slot of the entry holding indices, uploading them if needed
+    std::size_t find(std::span<const GLuint> indices);
+    std::size_t upload(std::span<const GLuint> indices);
+
+    std::vector<entry> _entries;
+    std::map<topology_key, std::size_t> _by_key;
+    // content hash to (indices, entry) pairs, the indices resolve collisions
+    std::unordered_map<std::uint64_t, std::vector<std::pair<std::vector<GLuint>, std::size_t>>> _by_hash;
+
+    GLsizeiptr _bytes = 0;
+    std::size_t _hits = 0;
+};
+
+// like create_mesh, but the indices come from the cache
+template <typename... Attributes>
+mesh create_mesh(const basic_shape<Attributes...>& shape, index_cache& cache, bool bake = true) {
+    if (bake && !shapes::is_baked(shape)) {
+        return create_mesh(shapes::baked(shape), cache, false);
+    }
+
+    index_cache::entry indices = cache.acquire(shape.indices);
+    return make_mesh<vertex_layout<Attributes...>>(shape.vertices, indices.ebo, indices.count, indices.type);
+}
+
+// skips hashing when the caller knows which generator built the shape
+//
+//     glh::mesh gauge = glh::create_mesh(ring, cache, {glh::topology::ring, 32});
+template <typename... Attributes>
+mesh create_mesh(const basic_shape<Attributes...>& shape, index_cache& cache, topology_key key, bool bake = true) {
+    if (bake && !shapes::is_baked(shape)) {
+        return create_mesh(shapes::baked(shape), cache, key, false);
+    }
+
+    index_cache::entry indices = cache.acquire(key, shape.indices);
+    return make_mesh<vertex_layout<Attributes...>>(shape.vertices, indices.ebo, indices.count, indices.type);
+}
+
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+// per-instance data consumed by glh::shader::instanced_vertex
+struct instance {
+    // rows of a 2x3 affine transform applied to the mesh's positions
+    std::array<GLfloat, 3> transform_x{1.0f, 0.0f, 0.0f};
+    std::array<GLfloat, 3> transform_y{0.0f, 1.0f, 0.0f};
+    std::array<GLfloat, 4> color{1.0f, 1.0f, 1.0f, 1.0f};
+};
+
+using instance_layout = vertex_layout<attributes::vec3, attributes::vec3, attributes::vec4>;
+
+static_assert(sizeof(instance) == instance_layout::stride, "instance must match its vertex layout");
+
+namespace instances {
+
+// scales, then rotates (in degrees) and then translates
+inline instance make_instance(GLfloat x, GLfloat y, GLfloat angle = 0.0f, GLfloat scale = 1.0f,
+                              std::array<GLfloat, 4> color = {1.0f, 0.84f, 0.1f, 1.0f}) {
+    angle = angle * std::numbers::pi / 180.0f;
+    GLfloat cos = scale * std::cos(angle);
+    GLfloat sin = scale * std::sin(angle);
+
+    return {{cos, -sin, x}, {sin, cos, y}, color};
+}
+
+}
+
+// a mesh uploaded once and drawn many times with a single glDrawElementsInstanced
+//
+// instance data lives in a CPU copy, writes only mark a dirty range
+// and flush() re-uploads that range before the next draw.
+template <typename... Attributes>
+class basic_instanced_mesh {
+public:
+    using layout = vertex_layout<Attributes...>;
+    using shape_type = basic_shape<Attributes...>;
+
+    explicit basic_instanced_mesh(const shape_type& mesh, GLsizei capacity = 64)
+        : _count(mesh.indices.size()), _capacity(std::max(capacity, 1)) {
+        shape_type baked = shapes::baked(mesh);
+
+        glGenVertexArrays(1, &_vao);
+        glGenBuffers(1, &_vbo);
+        glGenBuffers(1, &_ebo);
+        glGenBuffers(1, &_instance_vbo);
+
+        state().bind_vertex_array(_vao);
+
+        state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferData(GL_ARRAY_BUFFER, baked.vertices.size() * sizeof(typename layout::value_type),
+                     baked.vertices.data(), GL_STATIC_DRAW);
+        layout::enable();
+
+        state().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(GLuint), mesh.indices.data(),
+                     GL_STATIC_DRAW);
+
+        // instance attributes follow the mesh's own attributes
+        state().bind_buffer(GL_ARRAY_BUFFER, _instance_vbo);
+        glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(instance), NULL, GL_DYNAMIC_DRAW);
+        instance_layout::enable(layout::count, 1);
+
+        state().bind_vertex_array(0);
+        state().bind_buffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    basic_instanced_mesh(const basic_instanced_mesh&) = delete;
+    basic_instanced_mesh& operator=(const basic_instanced_mesh&) = delete;
+
+    ~basic_instanced_mesh() {
+        state().delete_vertex_arrays(1, &_vao);
+        state().delete_buffers(1, &_vbo);
+        state().delete_buffers(1, &_ebo);
+        state().delete_buffers(1, &_instance_vbo);
+    }
+
+    // returns the index of the new instance
+    GLsizei add(const instance& data) {
+        _instances.push_back(data);
+        mark(_instances.size() - 1);
+        return _instances.size() - 1;
+    }
+
+    void set(GLsizei index, const instance& data) {
+        _instances[index] = data;
+        mark(index);
+    }
+
+    const instance& operator[](GLsizei index) const {
+        return _instances[index];
+    }
+
+    // new instances are identity transforms
+    void resize(GLsizei size) {
+        GLsizei old = _instances.size();
+        _instances.resize(size);
+
+        if (size > old) {
+            _dirty_begin = std::min(_dirty_begin, old);
+            _dirty_end = size;
+        } else {
+            _dirty_end = std::min(_dirty_end, size);
+        }
+    }
+
+    // uploads the instances changed since the last flush
+    void flush() {
+        if (_dirty_begin >= _dirty_end) return;
+
+        state().bind_buffer(GL_ARRAY_BUFFER, _instance_vbo);
+
+        if ((GLsizei) _instances.size() > _capacity) {
+            // orphan the old storage and upload everything
+            while (_capacity < (GLsizei) _instances.size()) {
+                _capacity *= 2;
+            }
+            glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(instance), NULL, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, _instances.size() * sizeof(instance), _instances.data());
+        } else {
+            glBufferSubData(GL_ARRAY_BUFFER, _dirty_begin * sizeof(instance),
+                            (_dirty_end - _dirty_begin) * sizeof(instance), _instances.data() + _dirty_begin);
+        }
+
+        state().bind_buffer(GL_ARRAY_BUFFER, 0);
+
+        _dirty_begin = std::numeric_limits<GLsizei>::max();
+        _dirty_end = 0;
+    }
+
+    // binds the VAO and draws every instance
+    void draw(GLenum mode = GL_TRIANGLES) {
+        flush();
+
+        state().bind_vertex_array(_vao);
+        glDrawElementsInstanced(mode, _count, GL_UNSIGNED_INT, (GLvoid*) 0, _instances.size());
+    }
+
+    GLsizei size() const { return _instances.size(); }
+    GLuint vao() const { return _vao; }
+
+private:
+    void mark(GLsizei index) {
+        _dirty_begin = std::min(_dirty_begin, index);
+        _dirty_end = std::max(_dirty_end, index + 1);
+    }
+
+    GLuint _vao;
+    GLuint _vbo;
+    GLuint _ebo;
+    GLuint _instance_vbo;
+
+    GLsizei _count;
+    GLsizei _capacity;
+
+    std::vector<instance> _instances;
+    GLsizei _dirty_begin = std::numeric_limits<GLsizei>::max();
+    GLsizei _dirty_end = 0;
+};
+
+using instanced_mesh = basic_instanced_mesh<attributes::vec2>;
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+
+#include <glad/glad.h>
+
+namespace glh {
+
+// 2D affine transform
+// x' = a * x + b * y + c
+// y' = d * x + e * y + f
+struct affine {
+    GLfloat a, b, c;
+    GLfloat d, e, f;
+};
+
+namespace affines {
+
+constexpr affine identity() {
+    return {1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f};
+}
+
+constexpr affine translation(GLfloat delta_x, GLfloat delta_y) {
+    return {1.0f, 0.0f, delta_x, 0.0f, 1.0f, delta_y};
+}
+
+// angle in degrees, counterclockwise around the center
+inline affine rotation(GLfloat angle, GLfloat center_x = 0, GLfloat center_y = 0) {
+    angle = angle * std::numbers::pi / 180.0f;
+    GLfloat cos = std::cos(angle);
+    GLfloat sin = std::sin(angle);
+
+    return {
+        cos, -sin, center_x - center_x * cos + center_y * sin,
+        sin,  cos, center_y - center_x * sin - center_y * cos
+    };
+}
+
+constexpr affine scaling(GLfloat scale_x, GLfloat scale_y, GLfloat center_x = 0, GLfloat center_y = 0) {
+    return {scale_x, 0.0f, center_x - center_x * scale_x, 0.0f, scale_y, center_y - center_y * scale_y};
+}
+
+// applies rhs first, then lhs
+constexpr affine compose(const affine& lhs, const affine& rhs) {
+    return {
+        lhs.a * rhs.a + lhs.b * rhs.d, lhs.a * rhs.b + lhs.b * rhs.e, lhs.a * rhs.c + lhs.b * rhs.f + lhs.c,
+        lhs.d * rhs.a + lhs.e * rhs.d, lhs.d * rhs.b + lhs.e * rhs.e, lhs.d * rhs.c + lhs.e * rhs.f + lhs.f
+    };
+}
+
+}
+
+// vectorized transform kernels, the widest one the CPU supports is picked at runtime
+namespace kernels {
+
+enum class isa {
+    scalar,
+    sse2,
+    avx2
+};
+
+// instruction set used by transform, detected once
+isa selected();
+
+// transforms count xy pairs starting at xy, consecutive pairs are stride floats apart
+void transform(GLfloat* xy, std::size_t count, std::size_t stride, const affine& m);
+
+struct transform_job {
+    GLfloat* xy;
+    std::size_t count;
+    std::size_t stride;
+    affine m;
+};
+
+// runs many transforms with a single dispatch
+void transform(const transform_job* jobs, std::size_t count);
+
+}
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+namespace lod {
+
+// the fewest segments for which a chord of a circle with the given radius (in pixels)
+// strays at most tolerance pixels from the arc, for an arc spanning sweep degrees
+GLuint segments(GLfloat radius, GLfloat tolerance = 0.5f, GLfloat sweep = 360.0f);
+
+// radius in pixels of a circle of the given radius after projection,
+// projection may also include the model transform
+GLfloat projected_radius(const glm::mat4& projection, GLfloat radius, GLint viewport_width, GLint viewport_height);
+
+// rounds a segment count up to the nearest cached level (4, 6, 8, 12, 16, 24, ...)
+GLuint level(GLuint segments);
+
+}
+
+// a circle whose tessellation follows its size on screen
+//
+// levels are generated with glh::shapes::make_polygon the first time they're needed and kept,
+// a finer level is picked as soon as the error would exceed the tolerance, but a coarser one
+// only once the circle has shrunk by the hysteresis fraction past it, so zooming back and forth
+// across a boundary doesn't keep switching meshes.
+class circle_lod {
+public:
+    explicit circle_lod(GLfloat radius, GLfloat x = 0, GLfloat y = 0, GLfloat tolerance = 0.5f,
+                        GLfloat hysteresis = 0.25f);
+
+    circle_lod(const circle_lod&) = delete;
+    circle_lod& operator=(const circle_lod&) = delete;
+
+    // picks the level for the projection and viewport, generating it if it isn't cached
+    const mesh& select(const glm::mat4& projection, GLint viewport_width, GLint viewport_height);
+
+    void draw(const glm::mat4& projection, GLint viewport_width, GLint viewport_height);
+
+    // segments of the level picked by the last select
+    GLuint segments() const { return _segments; }
+    // number of levels generated so far
+    std::size_t cached() const { return _levels.size(); }
+
+private:
+    GLfloat _radius;
+    GLfloat _x;
+    GLfloat _y;
+    GLfloat _tolerance;
+    GLfloat _hysteresis;
+
+    GLuint _segments = 0;
+    std::vector<std::pair<GLuint, mesh>> _levels;
+};
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/resource.hpp>
+
+namespace glh {
+
+// many draws from the bound VAO issued with a single call
+//
+// the ranges are gathered into arrays for glMultiDrawElementsBaseVertex (or glMultiDrawArrays),
+// and when the context offers GL 4.3, into an indirect buffer built on the CPU and drawn with
+// glMultiDrawElementsIndirect, which leaves the driver one buffer upload instead of N draws.
+class multi_draw {
+public:
+    explicit multi_draw(bool allow_indirect = true);
+
+    multi_draw(const multi_draw&) = delete;
+    multi_draw& operator=(const multi_draw&) = delete;
+
+    // first is an index for indexed draws and a vertex otherwise, base_vertex only applies to indexed draws
+    void add(GLsizei count, GLuint first, GLint base_vertex = 0);
+    void clear();
+
+    // draws every range added since clear, GL_NONE draws arrays. the VAO must be bound
+    void draw(GLenum mode, GLenum index_type);
+
+    std::size_t size() const { return _counts.size(); }
+    // whether draw goes through the indirect buffer
+    bool indirect() const { return _indirect; }
+
+private:
+    // layouts read by glMultiDraw*Indirect
+    struct elements_command {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    struct arrays_command {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first;
+        GLuint base_instance;
+    };
+
+    void draw_indirect(GLenum mode, GLenum index_type);
+
+    bool _indirect;
+
+    std::vector<GLsizei> _counts;
+    std::vector<GLuint> _firsts;
+    std::vector<GLint> _base_vertices;
+    // scratch filled on every draw
+    std::vector<const GLvoid*> _offsets;
+    std::vector<GLint> _first_vertices;
+    std::vector<std::byte> _commands;
+
+    buffer_handle _buffer;
+    GLsizeiptr _capacity = 0;
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+namespace optimize {
+
+// size of the post-transform cache simulated by acmr and targeted by reorder_triangles
+constexpr GLuint CACHE_SIZE = 16;
+
+// average cache miss ratio: transformed vertices per triangle with a FIFO cache,
+// 3 means no reuse and 0.5 is the best a regular grid can reach
+GLfloat acmr(std::span<const GLuint> indices, GLuint cache_size = CACHE_SIZE);
+
+// merges vertices whose components all round to the same multiple of epsilon
+// and rewrites indices, returns the number of vertices left
+std::size_t weld(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices, GLuint components,
+                 GLfloat epsilon = 1e-5f);
+
+// reorders triangles so each vertex is reused while it is still in the cache (Tipsy, Sander et al. 2007)
+void reorder_triangles(std::vector<GLuint>& indices, std::size_t vertex_count, GLuint cache_size = CACHE_SIZE);
+
+// reorders vertices by first use so the vertex fetch reads memory front to back,
+// unused vertices are dropped
+void reorder_vertices(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices, GLuint components);
+
+struct report {
+    std::size_t vertices_before;
+    std::size_t vertices_after;
+    GLfloat acmr_before;
+    GLfloat acmr_after;
+};
+
+// welds, then reorders triangles and vertices, the shape must be a triangle list
+template <typename... Attributes>
+report run(basic_shape<Attributes...>& shape, GLfloat epsilon = 1e-5f) {
+    using layout = vertex_layout<Attributes...>;
+    static_assert(std::is_same_v<typename layout::value_type, GLfloat>, "only float vertices can be optimized");
+
+    report result;
+    result.vertices_before = shape.vertices.size() / layout::components;
+    result.acmr_before = acmr(shape.indices);
+
+    std::size_t count = weld(shape.vertices, shape.indices, layout::components, epsilon);
+    reorder_triangles(shape.indices, count);
+    reorder_vertices(shape.vertices, shape.indices, layout::components);
+
+    result.vertices_after = shape.vertices.size() / layout::components;
+    result.acmr_after = acmr(shape.indices);
+    return result;
+}
+
+}
+
+}
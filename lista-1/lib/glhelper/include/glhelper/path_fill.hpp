@@ -0,0 +1,60 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+enum class fill_rule {
+    even_odd,
+    nonzero
+};
+
+// fills arbitrary paths, concave or self-intersecting, with stencil-then-cover
+//
+// each contour is drawn as a triangle fan into the stencil buffer, which counts how many times
+// every pixel is wound, then a bounding quad is drawn where the count says the pixel is inside.
+// the cover pass clears the stencil it touches, so paths can be filled one after another.
+// only the raw outline is uploaded, nothing is triangulated on the CPU.
+//
+// the framebuffer needs a stencil buffer (GLFW creates an 8 bit one by default),
+// cleared once per frame with GL_STENCIL_BUFFER_BIT, and face culling must be off.
+class path_fill {
+public:
+    explicit path_fill(GLsizei capacity = 256);
+
+    path_fill(const path_fill&) = delete;
+    path_fill& operator=(const path_fill&) = delete;
+
+    ~path_fill();
+
+    // replaces the path with a single closed contour of xy pairs
+    void set_path(std::span<const GLfloat> outline);
+    // replaces the path with several closed contours, holes are contours wound the other way
+    void set_path(std::span<const std::vector<GLfloat>> contours);
+
+    // draws with the bound program, whose position attribute must be at location 0.
+    // GL_STENCIL_TEST is left as it was, but the stencil func, op and write mask stay at
+    // GL_NOTEQUAL, GL_ZERO and 0xFF and the color mask is fully enabled
+    void fill(fill_rule rule = fill_rule::nonzero) const;
+
+    GLuint vao() const { return _vao; }
+
+private:
+    void upload();
+
+    GLuint _vao;
+    GLuint _vbo;
+    GLsizei _capacity;
+
+    // contour points followed by the 4 corners of the bounding quad
+    std::vector<GLfloat> _vertices;
+    std::vector<GLint> _firsts;
+    std::vector<GLsizei> _counts;
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+enum class line_join : GLint {
+    // must match the constants in glh::shader::polyline_vertex
+    miter = 0,
+    round = 1
+};
+
+// thick antialiased line strips of any width, which core profiles don't offer through glLineWidth
+//
+// the points are uploaded once, every segment is an instance whose quad is extruded in
+// glh::shader::polyline_vertex, so redrawing costs no CPU work whatever the width or projection.
+// miter joins end in butt caps, round joins also round the caps.
+class polyline {
+public:
+    explicit polyline(GLsizei capacity = 1024);
+
+    polyline(const polyline&) = delete;
+    polyline& operator=(const polyline&) = delete;
+
+    ~polyline();
+
+    // replaces the strip with xy pairs, as drawn by GL_LINE_STRIP
+    void set_points(std::span<const GLfloat> points);
+
+    void set_projection(const glm::mat4& projection) const;
+    // width in pixels
+    void set_width(GLfloat width) const;
+    void set_join(line_join join) const;
+    void set_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a = 1.0f) const;
+
+    // binds the program and the VAO and draws the strip with alpha blending,
+    // GL_BLEND is left as it was but the blend function stays set
+    void draw() const;
+
+    GLuint program() const { return _program; }
+    GLsizei size() const { return _count; }
+
+private:
+    GLuint _program;
+    GLuint _vao;
+    GLuint _vbo;
+    GLsizei _capacity;
+    GLsizei _count = 0;
+
+    GLint _projection_location;
+    GLint _viewport_location;
+    GLint _width_location;
+    GLint _join_location;
+    GLint _color_location;
+};
+
+}
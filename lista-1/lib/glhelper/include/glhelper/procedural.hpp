@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+// draws polygons, stars and spirals without any vertex buffer
+//
+// positions are computed in glh::shader::procedural_vertex from gl_VertexID and a few uniforms,
+// so changing a shape's parameters costs no CPU work and no upload.
+// the output matches glh::shapes::make_polygon, make_star and make_spiral.
+class procedural {
+public:
+    // must match the constants in glh::shader::procedural_vertex
+    enum kind : GLint {
+        polygon = 0,
+        star = 1,
+        spiral = 2
+    };
+
+    static constexpr GLsizei SPIRAL_SIDES = 64;
+
+    procedural();
+
+    procedural(const procedural&) = delete;
+    procedural& operator=(const procedural&) = delete;
+
+    ~procedural();
+
+    // binds the program and the empty VAO, the draw functions expect them bound
+    void use() const;
+
+    void set_color(GLfloat r, GLfloat g, GLfloat b) const;
+
+    void draw_polygon(GLfloat radius, GLuint sides, GLfloat x = 0, GLfloat y = 0) const;
+    void draw_star(GLfloat radius, GLuint points, GLfloat x = 0, GLfloat y = 0) const;
+    void draw_spiral(GLfloat radius, GLuint loops, GLfloat x = 0, GLfloat y = 0) const;
+
+    GLuint program() const { return _program; }
+
+    static constexpr GLsizei vertex_count(kind kind, GLuint count) {
+        switch (kind) {
+            case polygon: return 3 * count;
+            case star:    return 6 * count;
+            default:      return SPIRAL_SIDES * count;
+        }
+    }
+
+private:
+    void draw(kind kind, GLfloat radius, GLuint count, GLfloat x, GLfloat y, GLenum mode) const;
+
+    GLuint _program;
+    GLuint _vao;
+
+    GLint _kind_location;
+    GLint _radius_location;
+    GLint _count_location;
+    GLint _center_location;
+    GLint _color_location;
+};
+
+}
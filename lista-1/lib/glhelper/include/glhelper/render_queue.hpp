@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/multi_draw.hpp>
+
+namespace glh {
+
+// uniform values uploaded through glh::state() before the draws that use them
+class uniform_set {
+public:
+    uniform_set& set(GLint location, GLint value);
+    uniform_set& set(GLint location, GLfloat value);
+    uniform_set& set(GLint location, const glm::vec2& value);
+    uniform_set& set(GLint location, const glm::vec3& value);
+    uniform_set& set(GLint location, const glm::vec4& value);
+    uniform_set& set(GLint location, const glm::mat3& value);
+    uniform_set& set(GLint location, const glm::mat4& value);
+
+    // uploads to the program in use
+    void apply() const;
+
+private:
+    struct value {
+        GLint location;
+        // 1 to 4 for scalars and vectors, 9 and 16 for matrices
+        GLsizei size;
+        bool integer;
+        std::array<GLfloat, 16> data;
+    };
+
+    uniform_set& set(GLint location, const GLfloat* data, GLsizei size, bool integer = false);
+
+    std::vector<value> _values;
+};
+
+// a draw recorded by a render_queue
+struct draw_item {
+    GLuint program;
+    GLuint vao;
+    // id from render_queue::add_uniforms
+    GLuint uniforms = NO_UNIFORMS;
+
+    GLenum mode = GL_TRIANGLES;
+    GLsizei count = 0;
+    // GL_NONE draws arrays
+    GLenum index_type = GL_NONE;
+    // first vertex, or first index of indexed draws
+    GLuint first = 0;
+    GLint base_vertex = 0;
+
+    static constexpr GLuint NO_UNIFORMS = ~0u;
+};
+
+// draws recorded in any order and issued sorted by a 64-bit key, once per frame
+//
+//     queue.submit(0, program, mesh, material);
+//     ...
+//     queue.flush();
+//
+// the default key holds, from the most significant bits, the layer (8 bits), the program (16),
+// the VAO (24) and the uniform set (16), so layers are drawn in order and every state change
+// happens as rarely as possible within one. names wider than their field only group less well.
+// draws with equal keys keep their submission order. consecutive draws sharing their program, VAO,
+// uniform set, mode and index type are issued as one call: adjacent ranges of a list primitive
+// are merged, the others go through glh::multi_draw.
+class render_queue {
+public:
+    static std::uint64_t make_key(GLubyte layer, GLuint program, GLuint vao, GLuint uniforms = draw_item::NO_UNIFORMS);
+
+    // uniform sets live as long as the queue, the returned id goes into draw_item::uniforms
+    GLuint add_uniforms(uniform_set uniforms);
+    uniform_set& uniforms(GLuint id) { return _uniforms[id]; }
+
+    // a custom key, e.g. one ordering transparent draws back to front
+    void submit_keyed(std::uint64_t key, const draw_item& item);
+    void submit(GLubyte layer, const draw_item& item);
+    void submit(GLubyte layer, GLuint program, const mesh& mesh, GLuint uniforms = draw_item::NO_UNIFORMS,
+                GLenum mode = GL_TRIANGLES);
+
+    // sorts and issues every draw submitted since the last flush, then forgets them
+    void flush();
+
+    // draws submitted to and calls issued by the last flush
+    std::size_t submitted() const { return _submitted; }
+    std::size_t batches() const { return _batches; }
+
+private:
+    struct entry {
+        std::uint64_t key;
+        GLuint item;
+    };
+
+    void sort();
+
+    std::vector<draw_item> _items;
+    std::vector<entry> _entries;
+    std::vector<entry> _scratch;
+    std::vector<uniform_set> _uniforms;
+    multi_draw _batch;
+
+    std::size_t _submitted = 0;
+    std::size_t _batches = 0;
+};
+
+}
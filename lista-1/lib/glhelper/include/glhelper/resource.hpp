@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/state.hpp>
+
+namespace glh {
+
+enum class object_kind {
+    buffer,
+    vertex_array
+};
+
+// buffer and VAO names generated in blocks, so creating objects rarely reaches glGen*
+//
+// released names are recycled: buffers lose their storage and VAOs forget their attributes and
+// index buffer before being handed out again. the pool never calls GL from its destructor,
+// names still pooled when the context is destroyed are reclaimed with it (see trim).
+class name_pool {
+public:
+    explicit name_pool(GLsizei block_size = 64);
+
+    name_pool(const name_pool&) = delete;
+    name_pool& operator=(const name_pool&) = delete;
+
+    GLuint acquire(object_kind kind);
+    // gives a name from acquire back for reuse, VAOs are left unbound
+    void release(object_kind kind, GLuint name);
+    // deletes a name from acquire instead of pooling it,
+    // GL keeps the object alive while a VAO still reads from it
+    void retire(object_kind kind, GLuint name);
+
+    // deletes every pooled name
+    void trim();
+
+    // names acquired and neither released nor retired
+    GLsizei live(object_kind kind) const { return _lists[(std::size_t) kind].live; }
+    GLsizei pooled(object_kind kind) const { return _lists[(std::size_t) kind].names.size(); }
+    // names generated so far, including retired and trimmed ones
+    GLsizei generated(object_kind kind) const { return _lists[(std::size_t) kind].generated; }
+
+private:
+    struct list {
+        std::vector<GLuint> names;
+        GLsizei live = 0;
+        GLsizei generated = 0;
+    };
+
+    void reset_vertex_array(GLuint name);
+
+    GLsizei _block_size;
+    std::array<list, 2> _lists;
+    GLint _max_attributes = 0;
+};
+
+// the pool of the current context, used by create_vao and the handles below
+name_pool& names();
+
+// move-only owner of a GL name, Deleter frees it on destruction
+template <typename Deleter>
+class gl_handle {
+public:
+    gl_handle() = default;
+    explicit gl_handle(GLuint name) : _name(name) {}
+
+    gl_handle(const gl_handle&) = delete;
+    gl_handle& operator=(const gl_handle&) = delete;
+
+    gl_handle(gl_handle&& other) noexcept : _name(std::exchange(other._name, 0)) {}
+
+    gl_handle& operator=(gl_handle&& other) noexcept {
+        if (this != &other) {
+            reset(std::exchange(other._name, 0));
+        }
+        return *this;
+    }
+
+    ~gl_handle() { reset(); }
+
+    GLuint get() const { return _name; }
+    operator GLuint() const { return _name; }
+    explicit operator bool() const { return _name != 0; }
+
+    // gives up ownership without freeing the name
+    GLuint release() { return std::exchange(_name, 0); }
+
+    void reset(GLuint name = 0) {
+        if (_name != 0) {
+            Deleter{}(_name);
+        }
+        _name = name;
+    }
+
+private:
+    GLuint _name = 0;
+};
+
+namespace deleters {
+
+struct buffer {
+    void operator()(GLuint name) const { names().release(object_kind::buffer, name); }
+};
+
+struct vertex_array {
+    void operator()(GLuint name) const { names().release(object_kind::vertex_array, name); }
+};
+
+struct shader {
+    void operator()(GLuint name) const { glDeleteShader(name); }
+};
+
+struct program {
+    void operator()(GLuint name) const { state().delete_program(name); }
+};
+
+}
+
+// buffers and VAOs must come from names(), like those made by make_buffer, make_vao and create_vao
+using buffer_handle = gl_handle<deleters::buffer>;
+using vao_handle = gl_handle<deleters::vertex_array>;
+using shader_handle = gl_handle<deleters::shader>;
+using program_handle = gl_handle<deleters::program>;
+
+inline buffer_handle make_buffer() {
+    return buffer_handle(names().acquire(object_kind::buffer));
+}
+
+inline vao_handle make_vao() {
+    return vao_handle(names().acquire(object_kind::vertex_array));
+}
+
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+// circles, rounded rectangles, regular polygons and stars drawn as one quad each
+//
+// glh::shader::sdf_fragment evaluates each shape's distance function per pixel and fades the
+// edge over one pixel, so outlines stay smooth at any size without MSAA.
+// every shape added since clear is drawn by a single instanced call, whatever its kind.
+// polygons and stars have their first vertex along +x, like glh::shapes::make_polygon and make_star.
+class sdf_batch {
+public:
+    // must match the constants in glh::shader::sdf_fragment
+    enum kind : GLint {
+        circle = 0,
+        rounded_rect = 1,
+        polygon = 2,
+        star = 3
+    };
+
+    using rgba = std::array<GLfloat, 4>;
+
+    explicit sdf_batch(GLsizei capacity = 256);
+
+    sdf_batch(const sdf_batch&) = delete;
+    sdf_batch& operator=(const sdf_batch&) = delete;
+
+    ~sdf_batch();
+
+    // angles are in degrees, counterclockwise, shapes are centered on (x, y)
+    void add_circle(GLfloat x, GLfloat y, GLfloat radius, rgba color = DEFAULT_COLOR);
+    void add_rounded_rect(GLfloat x, GLfloat y, GLfloat width, GLfloat height, GLfloat corner_radius,
+                          GLfloat angle = 0, rgba color = DEFAULT_COLOR);
+    void add_polygon(GLfloat x, GLfloat y, GLfloat radius, GLuint sides, GLfloat angle = 0,
+                     rgba color = DEFAULT_COLOR);
+    // inner is the radius of the valleys relative to radius, make_star uses 0.5
+    void add_star(GLfloat x, GLfloat y, GLfloat radius, GLuint points, GLfloat angle = 0,
+                  rgba color = DEFAULT_COLOR, GLfloat inner = 0.5f);
+    void clear();
+
+    void set_projection(const glm::mat4& projection) const;
+
+    // binds the program and the VAO and draws every shape with alpha blending,
+    // GL_BLEND is left as it was but the blend function stays set
+    void draw();
+
+    GLuint program() const { return _program; }
+    GLsizei size() const { return _instances.size(); }
+
+private:
+    static constexpr rgba DEFAULT_COLOR{1.0f, 0.84f, 0.1f, 1.0f};
+
+    struct instance {
+        std::array<GLfloat, 4> bounds;
+        std::array<GLfloat, 4> shape;
+        rgba color;
+    };
+
+    void add(kind kind, GLfloat x, GLfloat y, GLfloat half_width, GLfloat half_height, GLfloat count,
+             GLfloat parameter, GLfloat angle, const rgba& color);
+
+    GLuint _program;
+    GLuint _vao;
+    GLuint _vbo;
+    GLsizei _capacity;
+
+    GLint _projection_location;
+
+    std::vector<instance> _instances;
+    bool _dirty = false;
+};
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+namespace sprites {
+
+using color = std::array<GLfloat, 3>;
+
+// 2D grid of palette indices, the first row is the top of the sprite
+struct bitmap {
+    static constexpr GLubyte empty = 0xFF;
+
+    GLsizei width = 0;
+    GLsizei height = 0;
+    std::vector<GLubyte> cells;
+
+    GLubyte at(GLsizei x, GLsizei y) const {
+        return cells[y * width + x];
+    }
+};
+
+// one string per row, the character key[i] stands for palette index i and anything else is empty
+//
+//     constexpr std::array<std::string_view, 2> rows{
+//         ".RR.",
+//         "RSSR"
+//     };
+//     glh::sprites::bitmap b = glh::sprites::make_bitmap(rows, "RS");
+bitmap make_bitmap(std::span<const std::string_view> rows, std::string_view key);
+
+// reads a binary (P6) or plain (P3) netpbm image, every distinct color is added to the palette
+// and pixels of the transparent color are left empty
+bitmap load_ppm(const std::string& path, std::vector<color>& palette, color transparent = {1.0f, 0.0f, 1.0f});
+
+// merges runs of same-colored cells into as few rectangles as possible (greedy meshing)
+// each cell is pixel_size wide and (left, top) is the top left corner of the sprite
+color_shape greedy_mesh(const bitmap& bitmap, std::span<const color> palette, GLfloat pixel_size,
+                        GLfloat left = 0, GLfloat top = 0);
+
+// RGBA8 texture holding many sprites, sampled with GL_NEAREST
+//
+// bitmaps are packed on shelves, left to right and bottom to top, with a texel of padding.
+class atlas {
+public:
+    struct region {
+        // texture coordinates, v0 is the bottom of the sprite
+        GLfloat u0, v0, u1, v1;
+        GLsizei width, height;
+    };
+
+    explicit atlas(GLsizei width = 1024, GLsizei height = 1024);
+
+    atlas(const atlas&) = delete;
+    atlas& operator=(const atlas&) = delete;
+
+    ~atlas();
+
+    // uploads the bitmap with its palette colors, empty cells are transparent
+    region add(const bitmap& bitmap, std::span<const color> palette);
+
+    void bind(GLuint unit = 0) const;
+
+    GLuint texture() const { return _texture; }
+
+private:
+    GLuint _texture;
+    GLsizei _width;
+    GLsizei _height;
+
+    GLsizei _shelf_x = 0;
+    GLsizei _shelf_y = 0;
+    GLsizei _shelf_height = 0;
+};
+
+// draws atlas regions as one textured quad each, all of them with a single instanced draw
+//
+// the quad's corners come from gl_VertexID, the only buffer holds one rectangle per sprite,
+// so the cost of a sprite does not depend on how detailed it is.
+class sprite_batch {
+public:
+    explicit sprite_batch(GLsizei capacity = 256);
+
+    sprite_batch(const sprite_batch&) = delete;
+    sprite_batch& operator=(const sprite_batch&) = delete;
+
+    ~sprite_batch();
+
+    // each texel of the region becomes a pixel_size square, (left, top) is the top left corner
+    void add(const atlas::region& region, GLfloat pixel_size, GLfloat left, GLfloat top);
+    void clear();
+
+    // binds the program, the atlas and the VAO and draws every sprite added since clear
+    void draw(const atlas& atlas);
+
+    GLuint program() const { return _program; }
+
+private:
+    struct quad {
+        std::array<GLfloat, 4> rect;
+        std::array<GLfloat, 4> uv;
+    };
+
+    GLuint _program;
+    GLuint _vao;
+    GLuint _vbo;
+    GLsizei _capacity;
+
+    std::vector<quad> _quads;
+    bool _dirty = false;
+};
+
+}
+
+}
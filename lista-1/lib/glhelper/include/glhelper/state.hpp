@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+namespace glh {
+
+// shadows the bound program, VAO and buffers, the polygon mode, the viewport and uniform values,
+// skipping GL calls that would leave them unchanged
+//
+// glhelper binds and deletes through state(), so it stays in sync with the library.
+// after changing any of this state with plain GL calls, call invalidate. uniforms are cached per
+// program and location, a location set with glUniform* directly must not also be set here.
+// the element array buffer belongs to the VAO, so it is forgotten whenever the VAO changes.
+class state_cache {
+public:
+    state_cache();
+
+    state_cache(const state_cache&) = delete;
+    state_cache& operator=(const state_cache&) = delete;
+
+    void use_program(GLuint program);
+    void bind_vertex_array(GLuint vao);
+    // targets other than the common vertex, index, copy, uniform and indirect ones are always bound
+    void bind_buffer(GLenum target, GLuint buffer);
+    // indexed GL_UNIFORM_BUFFER bindings below UNIFORM_BINDINGS are shadowed, others always bound.
+    // like GL, both also bind the buffer to the target itself
+    void bind_buffer_base(GLenum target, GLuint index, GLuint buffer);
+    void bind_buffer_range(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+    // for GL_FRONT_AND_BACK, the only face core profiles accept
+    void polygon_mode(GLenum mode);
+    void viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+    // upload to the program in use, like glUniform*
+    void uniform(GLint location, GLint value);
+    void uniform(GLint location, GLfloat value);
+    void uniform(GLint location, const glm::vec2& value);
+    void uniform(GLint location, const glm::vec3& value);
+    void uniform(GLint location, const glm::vec4& value);
+    void uniform(GLint location, const glm::mat3& value);
+    void uniform(GLint location, const glm::mat4& value);
+
+    // delete like glDelete*, forgetting the names so reused ones are bound again
+    void delete_vertex_arrays(GLsizei count, const GLuint* vaos);
+    void delete_buffers(GLsizei count, const GLuint* buffers);
+    void delete_program(GLuint program);
+
+    // forgets everything, the next call of each kind reaches GL
+    void invalidate();
+
+    // calls made and calls skipped since the last reset_counters
+    std::size_t issued() const { return _issued; }
+    std::size_t skipped() const { return _skipped; }
+    void reset_counters();
+
+    // number of buffer targets whose binding is shadowed
+    static constexpr std::size_t TRACKED_TARGETS = 7;
+    static constexpr GLuint UNIFORM_BINDINGS = 16;
+
+private:
+    static constexpr GLuint UNKNOWN = ~0u;
+
+    struct indexed_binding {
+        GLuint buffer;
+        GLintptr offset;
+        // -1 for the whole buffer
+        GLsizeiptr size;
+
+        bool operator==(const indexed_binding&) const = default;
+    };
+
+    struct uniform_value {
+        std::array<GLfloat, 16> data;
+        GLsizei size = 0;
+    };
+
+    // records the value and tells whether the upload can be skipped
+    bool cached(GLint location, const GLfloat* data, GLsizei size);
+    bool skip(bool unchanged);
+
+    GLuint _program;
+    GLuint _vao;
+    std::array<GLuint, TRACKED_TARGETS> _buffers;
+    std::array<indexed_binding, UNIFORM_BINDINGS> _uniform_bindings;
+    GLenum _polygon_mode;
+    std::array<GLint, 4> _viewport;
+    bool _viewport_known;
+
+    // indexed by program, then by location
+    std::unordered_map<GLuint, std::vector<uniform_value>> _uniforms;
+
+    std::size_t _issued = 0;
+    std::size_t _skipped = 0;
+};
+
+// the state of the current context
+state_cache& state();
+
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <numbers>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+// trigonometry usable in constant expressions, accurate to about 1e-13
+namespace cmath {
+
+// reduces x to [-pi, pi]
+constexpr double reduce(double x) {
+    constexpr double TAU = 2 * std::numbers::pi;
+
+    double turns = x / TAU;
+    long long whole = turns < 0 ? (long long) (turns - 0.5) : (long long) (turns + 0.5);
+    return x - whole * TAU;
+}
+
+constexpr double sin(double x) {
+    x = reduce(x);
+
+    double term = x;
+    double sum = x;
+    for (int i = 1; i < 14; ++i) {
+        term *= -x * x / ((2 * i) * (2 * i + 1));
+        sum += term;
+    }
+
+    return sum;
+}
+
+constexpr double cos(double x) {
+    x = reduce(x);
+
+    double term = 1;
+    double sum = 1;
+    for (int i = 1; i < 14; ++i) {
+        term *= -x * x / ((2 * i - 1) * (2 * i));
+        sum += term;
+    }
+
+    return sum;
+}
+
+}
+
+// a shape with a size fixed at compile time, so it can be built in a constant expression
+// and stored in read-only data
+template <std::size_t VertexCount, std::size_t IndexCount>
+struct static_shape {
+    using layout = vertex_layout<attributes::vec2>;
+
+    static constexpr std::size_t vertex_count = VertexCount;
+    static constexpr std::size_t index_count = IndexCount;
+
+    std::array<GLfloat, VertexCount * 2> vertices{};
+    std::array<GLuint, IndexCount> indices{};
+
+    // copies into a regular shape
+    shape to_shape() const {
+        return {{vertices.begin(), vertices.end()}, {indices.begin(), indices.end()}};
+    }
+};
+
+template <std::size_t V, std::size_t I>
+GLuint create_vao(const static_shape<V, I>& shape) {
+    return create_vao<vertex_layout<attributes::vec2>>(std::span<const GLfloat>(shape.vertices),
+                                                       std::span<const GLuint>(shape.indices));
+}
+
+template <std::size_t V, std::size_t I>
+mesh create_mesh(const static_shape<V, I>& shape) {
+    GLenum type = index_type(shape.indices);
+    std::vector<GLubyte> packed = pack_indices(shape.indices, type);
+
+    return make_mesh<vertex_layout<attributes::vec2>>(std::span<const GLfloat>(shape.vertices), packed, (GLsizei) I, type);
+}
+
+// compile-time counterparts of glh::shapes with the same vertex order and topology
+//
+//     constexpr auto circle = glh::shapes::fixed::make_polygon<60>(0.5f);
+namespace shapes::fixed {
+
+constexpr static_shape<3, 3> make_triangle(GLfloat radius, GLfloat x = 0, GLfloat y = 0) {
+    constexpr double slice = 2 * std::numbers::pi / 3;
+
+    static_shape<3, 3> result;
+    for (std::size_t i = 0; i < 3; ++i) {
+        result.vertices[2 * i]     = radius * cmath::cos(i * slice) + x;
+        result.vertices[2 * i + 1] = radius * cmath::sin(i * slice) + y;
+        result.indices[i] = i;
+    }
+
+    return result;
+}
+
+constexpr static_shape<4, 6> make_rectangle(GLfloat width, GLfloat height) {
+    return {
+        {0.0f, 0.0f, 0.0f, height, width, height, width, 0.0f},
+        {0, 1, 3, 1, 2, 3}
+    };
+}
+
+template <GLuint Sides>
+constexpr static_shape<Sides + 1, Sides * 3> make_polygon(GLfloat radius, GLfloat x = 0, GLfloat y = 0) {
+    constexpr double slice = 2 * std::numbers::pi / Sides;
+
+    static_shape<Sides + 1, Sides * 3> result;
+    for (GLuint i = 0; i < Sides; ++i) {
+        result.vertices[2 * i]     = radius * cmath::cos(i * slice) + x;
+        result.vertices[2 * i + 1] = radius * cmath::sin(i * slice) + y;
+
+        result.indices[i * 3]     = i;
+        result.indices[i * 3 + 1] = (i + 1) % Sides;
+        result.indices[i * 3 + 2] = Sides;
+    }
+
+    result.vertices[2 * Sides]     = x;
+    result.vertices[2 * Sides + 1] = y;
+
+    return result;
+}
+
+template <GLuint Points>
+constexpr static_shape<Points * 2 + 1, Points * 6> make_star(GLfloat radius, GLfloat x = 0, GLfloat y = 0) {
+    constexpr GLuint RIM = Points * 2;
+    constexpr double slice = 2 * std::numbers::pi / RIM;
+
+    static_shape<RIM + 1, RIM * 3> result;
+    for (GLuint i = 0; i < RIM; ++i) {
+        double r = (i % 2 == 0 ? 1 : 0.5) * radius;
+        result.vertices[2 * i]     = r * cmath::cos(i * slice) + x;
+        result.vertices[2 * i + 1] = r * cmath::sin(i * slice) + y;
+
+        result.indices[i * 3]     = i;
+        result.indices[i * 3 + 1] = (i + 1) % RIM;
+        result.indices[i * 3 + 2] = RIM;
+    }
+
+    result.vertices[2 * RIM]     = x;
+    result.vertices[2 * RIM + 1] = y;
+
+    return result;
+}
+
+// line strip points, like glh::shapes::make_spiral
+template <GLuint Loops>
+constexpr std::array<GLfloat, 64 * Loops * 2> make_spiral(GLfloat radius, GLfloat x = 0, GLfloat y = 0) {
+    constexpr GLuint SIDES = 64;
+    constexpr double slice = 2 * std::numbers::pi / SIDES;
+
+    std::array<GLfloat, SIDES * Loops * 2> result{};
+    for (GLuint i = 0; i < SIDES * Loops; ++i) {
+        double r = radius * i / (SIDES * Loops);
+        result[2 * i]     = r * cmath::cos(i * slice) + x;
+        result[2 * i + 1] = r * cmath::sin(i * slice) + y;
+    }
+
+    return result;
+}
+
+template <std::size_t V, std::size_t I>
+constexpr static_shape<V, I> translate(static_shape<V, I> shape, GLfloat delta_x, GLfloat delta_y) {
+    for (std::size_t i = 0; i < V; ++i) {
+        shape.vertices[2 * i]     += delta_x;
+        shape.vertices[2 * i + 1] += delta_y;
+    }
+
+    return shape;
+}
+
+// angle in degrees, counterclockwise around the center
+template <std::size_t V, std::size_t I>
+constexpr static_shape<V, I> rotate(static_shape<V, I> shape, GLfloat angle, GLfloat center_x, GLfloat center_y) {
+    double radians = angle * std::numbers::pi / 180.0;
+    double cos = cmath::cos(radians);
+    double sin = cmath::sin(radians);
+
+    for (std::size_t i = 0; i < V; ++i) {
+        double x = shape.vertices[2 * i] - center_x;
+        double y = shape.vertices[2 * i + 1] - center_y;
+
+        shape.vertices[2 * i]     = x * cos - y * sin + center_x;
+        shape.vertices[2 * i + 1] = y * cos + x * sin + center_y;
+    }
+
+    return shape;
+}
+
+// concatenates shapes, rebasing the indices of each one
+template <std::size_t... V, std::size_t... I>
+constexpr static_shape<(V + ...), (I + ...)> group(const static_shape<V, I>&... shapes) {
+    static_shape<(V + ...), (I + ...)> result;
+
+    std::size_t vertex = 0;
+    std::size_t index = 0;
+    auto append = [&](const auto& shape) {
+        for (std::size_t i = 0; i < shape.indices.size(); ++i) {
+            result.indices[index++] = shape.indices[i] + vertex;
+        }
+        for (std::size_t i = 0; i < shape.vertices.size(); ++i) {
+            result.vertices[2 * vertex + i] = shape.vertices[i];
+        }
+        vertex += shape.vertices.size() / 2;
+    };
+    (append(shapes), ...);
+
+    return result;
+}
+
+}
+
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/resource.hpp>
+
+namespace glh {
+
+// binding points of the blocks create_shader_program connects by name,
+// GLSL 330 has no layout (binding = n) for them
+constexpr GLuint FRAME_BINDING = 0;
+constexpr GLuint MATERIAL_BINDING = 1;
+
+// connects a uniform block to a binding point, does nothing if the program has no such block
+void bind_uniform_block(GLuint program, const GLchar* name, GLuint binding);
+
+namespace std140 {
+
+// base alignment and size of a member, in bytes
+template <typename T>
+struct rules;
+
+template <> struct rules<GLfloat>   { static constexpr GLsizei alignment = 4,  size = 4;  };
+template <> struct rules<GLint>     { static constexpr GLsizei alignment = 4,  size = 4;  };
+template <> struct rules<GLuint>    { static constexpr GLsizei alignment = 4,  size = 4;  };
+template <> struct rules<glm::vec2> { static constexpr GLsizei alignment = 8,  size = 8;  };
+template <> struct rules<glm::vec3> { static constexpr GLsizei alignment = 16, size = 12; };
+template <> struct rules<glm::vec4> { static constexpr GLsizei alignment = 16, size = 16; };
+// matrices are arrays of columns, each padded to a vec4
+template <> struct rules<glm::mat3> { static constexpr GLsizei alignment = 16, size = 48; };
+template <> struct rules<glm::mat4> { static constexpr GLsizei alignment = 16, size = 64; };
+
+template <typename T>
+void write(std::byte* out, const T& value) {
+    if constexpr (std::is_same_v<T, glm::mat3>) {
+        for (int column = 0; column < 3; ++column) {
+            std::memcpy(out + column * 16, &value[column], sizeof(glm::vec3));
+        }
+    } else {
+        std::memcpy(out, &value, rules<T>::size);
+    }
+}
+
+}
+
+// the std140 layout of a uniform block whose members have the given types, in order
+//
+//     using material = glh::std140_layout<glm::vec4, GLfloat>;
+//     std::array<std::byte, material::size> data;
+//     material::write(data.data(), color, roughness);
+template <typename... Members>
+struct std140_layout {
+    static constexpr std::size_t count = sizeof...(Members);
+
+    // byte offset of each member
+    static constexpr std::array<GLsizei, count> offsets = [] {
+        std::array<GLsizei, count> result{};
+        std::array<GLsizei, count> alignments{std140::rules<Members>::alignment...};
+        std::array<GLsizei, count> sizes{std140::rules<Members>::size...};
+
+        GLsizei offset = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            offset = (offset + alignments[i] - 1) / alignments[i] * alignments[i];
+            result[i] = offset;
+            offset += sizes[i];
+        }
+        return result;
+    }();
+
+    // the block is padded to a multiple of a vec4, like a std140 struct
+    static constexpr GLsizei size = [] {
+        GLsizei end = 0;
+        std::array<GLsizei, count> sizes{std140::rules<Members>::size...};
+        for (std::size_t i = 0; i < count; ++i) {
+            end = std::max(end, offsets[i] + sizes[i]);
+        }
+        return (end + 15) / 16 * 16;
+    }();
+
+    static void write(std::byte* out, const Members&... values) {
+        write(out, std::index_sequence_for<Members...>{}, values...);
+    }
+
+private:
+    template <std::size_t... I>
+    static void write(std::byte* out, std::index_sequence<I...>, const Members&... values) {
+        (std140::write(out + offsets[I], values), ...);
+    }
+};
+
+// the frame block of glh::shader::frame_vertex, bound once at FRAME_BINDING
+//
+// every program created by create_shader_program reads the same camera, so switching programs
+// needs no uploads. changes are sent by update, at most once per frame.
+class frame_uniforms {
+public:
+    // projection, view, time
+    using layout = std140_layout<glm::mat4, glm::mat4, GLfloat>;
+
+    frame_uniforms();
+
+    frame_uniforms(const frame_uniforms&) = delete;
+    frame_uniforms& operator=(const frame_uniforms&) = delete;
+
+    void set_projection(const glm::mat4& projection);
+    void set_view(const glm::mat4& view);
+    // seconds, e.g. from glfwGetTime
+    void set_time(GLfloat time);
+
+    // uploads the block if anything changed
+    void update();
+
+private:
+    buffer_handle _buffer;
+    std::array<std::byte, layout::size> _data{};
+    bool _dirty = true;
+};
+
+// per-material blocks written each frame into a ring of regions, a draw binds one by index
+//
+// each frame fills the next region through an unsynchronized mapping, so the CPU never waits for
+// the GPU unless it is more than regions - 1 frames behind, which fences guard against.
+// bind makes a material visible at MATERIAL_BINDING with a single glBindBufferRange.
+//
+//     using material = glh::std140_layout<glm::vec4>;
+//     glh::material_ring materials(material::size);
+//     ...
+//     materials.begin_frame();
+//     GLuint red = materials.add<material>(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+//     materials.bind(red);
+class material_ring {
+public:
+    explicit material_ring(GLsizeiptr material_size, GLsizei capacity = 256, GLsizei regions = 3);
+
+    material_ring(const material_ring&) = delete;
+    material_ring& operator=(const material_ring&) = delete;
+
+    ~material_ring();
+
+    // moves to the next region, materials added during the previous frame are forgotten
+    void begin_frame();
+
+    // copies material_size bytes into the current region and returns their index,
+    // the capacity doubles when a frame needs more materials
+    GLuint add(const GLvoid* material);
+
+    template <typename Layout, typename... Members>
+    GLuint add(const Members&... values) {
+        _scratch.assign(_material_size, std::byte{0});
+        Layout::write(_scratch.data(), values...);
+        return add(_scratch.data());
+    }
+
+    // uploads the materials added since the last bind and binds one at MATERIAL_BINDING
+    void bind(GLuint index);
+
+    GLsizei size() const { return (GLsizei) (_staging.size() / _stride); }
+    GLsizei capacity() const { return _capacity; }
+
+private:
+    void allocate();
+    void upload();
+
+    GLsizeiptr _material_size;
+    // material size rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+    GLsizeiptr _stride;
+    GLsizei _capacity;
+    GLsizei _regions;
+    GLsizei _region = 0;
+
+    buffer_handle _buffer;
+    std::vector<GLsync> _fences;
+
+    // this frame's materials, kept to refill a grown buffer
+    std::vector<std::byte> _staging;
+    std::vector<std::byte> _scratch;
+    GLsizeiptr _uploaded = 0;
+};
+
+}
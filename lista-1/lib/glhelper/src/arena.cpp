@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/arena.hpp>
+
+namespace glh {
+
+range_allocator::range_allocator(GLsizei capacity) : _capacity(capacity) {
+    if (capacity > 0) {
+        _free.push_back({0, capacity});
+    }
+}
+
+GLsizei range_allocator::allocate(GLsizei size) {
+    if (size == 0) return 0;
+
+    for (auto it = _free.begin(); it != _free.end(); ++it) {
+        if (it->size < size) continue;
+
+        GLsizei offset = it->offset;
+        it->offset += size;
+        it->size -= size;
+        if (it->size == 0) {
+            _free.erase(it);
+        }
+
+        return offset;
+    }
+
+    return npos;
+}
+
+void range_allocator::free(GLsizei offset, GLsizei size) {
+    if (size == 0) return;
+
+    auto next = std::lower_bound(_free.begin(), _free.end(), offset, [](const range& r, GLsizei o) {
+        return r.offset < o;
+    });
+
+    // merge with the neighbours so the list never holds adjacent ranges
+    bool merge_prev = next != _free.begin() && (next - 1)->offset + (next - 1)->size == offset;
+    bool merge_next = next != _free.end() && offset + size == next->offset;
+
+    if (merge_prev && merge_next) {
+        (next - 1)->size += size + next->size;
+        _free.erase(next);
+    } else if (merge_prev) {
+        (next - 1)->size += size;
+    } else if (merge_next) {
+        next->offset = offset;
+        next->size += size;
+    } else {
+        _free.insert(next, {offset, size});
+    }
+}
+
+void range_allocator::grow(GLsizei capacity) {
+    if (capacity <= _capacity) return;
+
+    GLsizei old = _capacity;
+    _capacity = capacity;
+    free(old, capacity - old);
+}
+
+void range_allocator::reset(GLsizei used) {
+    _free.clear();
+    if (used < _capacity) {
+        _free.push_back({used, _capacity - used});
+    }
+}
+
+GLsizei range_allocator::available() const {
+    GLsizei total = 0;
+    for (const range& r : _free) {
+        total += r.size;
+    }
+    return total;
+}
+
+}
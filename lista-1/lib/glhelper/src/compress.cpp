@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/compress.hpp>
+
+namespace glh {
+
+half to_half(GLfloat value) {
+    std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    std::uint16_t sign = (bits >> 16) & 0x8000;
+    std::int32_t exponent = ((bits >> 23) & 0xFF) - 127 + 15;
+    std::uint32_t mantissa = bits & 0x7FFFFF;
+
+    // infinities and NaNs keep their class
+    if (((bits >> 23) & 0xFF) == 0xFF) {
+        return {(GLushort) (sign | 0x7C00 | (mantissa ? 0x200 : 0))};
+    }
+
+    if (exponent >= 31) {
+        return {(GLushort) (sign | 0x7C00)};
+    }
+
+    if (exponent <= 0) {
+        // subnormal or zero, shift the implicit bit in and round to nearest even
+        if (exponent < -10) return {sign};
+
+        mantissa |= 0x800000;
+        std::uint32_t shift = 14 - exponent;
+        std::uint32_t result = mantissa >> shift;
+        std::uint32_t rest = mantissa & ((1u << shift) - 1);
+        std::uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (result & 1))) ++result;
+
+        return {(GLushort) (sign | result)};
+    }
+
+    std::uint32_t result = (exponent << 10) | (mantissa >> 13);
+    std::uint32_t rest = mantissa & 0x1FFF;
+    // a carry out of the mantissa correctly bumps the exponent, up to infinity
+    if (rest > 0x1000 || (rest == 0x1000 && (result & 1))) ++result;
+
+    return {(GLushort) (sign | result)};
+}
+
+GLfloat from_half(half value) {
+    std::uint32_t sign = (value.bits & 0x8000) << 16;
+    std::uint32_t exponent = (value.bits >> 10) & 0x1F;
+    std::uint32_t mantissa = value.bits & 0x3FF;
+
+    if (exponent == 0) {
+        GLfloat magnitude = std::ldexp((GLfloat) mantissa, -24);
+        return sign ? -magnitude : magnitude;
+    }
+    if (exponent == 31) {
+        return std::bit_cast<GLfloat>(sign | 0x7F800000 | (mantissa << 13));
+    }
+
+    return std::bit_cast<GLfloat>(sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+}
+
+template <typename T>
+static void append(std::vector<GLubyte>& out, T value) {
+    GLubyte bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+glm::mat3 compress_vertices(std::span<const GLfloat> vertices, std::span<const GLint> attribute_sizes,
+                            position_encoding encoding, std::vector<GLubyte>& out) {
+    GLint components = 2;
+    for (GLint size : attribute_sizes) {
+        components += size;
+    }
+
+    std::size_t count = vertices.size() / components;
+
+    glm::vec2 min{std::numeric_limits<GLfloat>::max()};
+    glm::vec2 max{std::numeric_limits<GLfloat>::lowest()};
+    for (std::size_t i = 0; i < count; ++i) {
+        const GLfloat* vertex = vertices.data() + i * components;
+        min = glm::vec2(std::min(min.x, vertex[0]), std::min(min.y, vertex[1]));
+        max = glm::vec2(std::max(max.x, vertex[0]), std::max(max.y, vertex[1]));
+    }
+
+    if (count == 0) {
+        min = max = glm::vec2(0.0f);
+    }
+
+    glm::vec2 size(std::max(max.x - min.x, std::numeric_limits<GLfloat>::min()),
+                   std::max(max.y - min.y, std::numeric_limits<GLfloat>::min()));
+    glm::vec2 center((min.x + max.x) / 2, (min.y + max.y) / 2);
+
+    out.clear();
+    out.reserve(count * (4 + 4 * attribute_sizes.size()));
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const GLfloat* vertex = vertices.data() + i * components;
+
+        if (encoding == position_encoding::half_float) {
+            append(out, to_half(vertex[0] - center.x));
+            append(out, to_half(vertex[1] - center.y));
+        } else {
+            append(out, (GLushort) std::lround((vertex[0] - min.x) / size.x * 65535.0f));
+            append(out, (GLushort) std::lround((vertex[1] - min.y) / size.y * 65535.0f));
+        }
+
+        const GLfloat* attribute = vertex + 2;
+        for (GLint attribute_size : attribute_sizes) {
+            for (GLint c = 0; c < 4; ++c) {
+                GLfloat value = c < attribute_size ? attribute[c] : 1.0f;
+                out.push_back((GLubyte) std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+            }
+            attribute += attribute_size;
+        }
+    }
+
+    // columns of the matrix taking the stored values back to the original positions
+    if (encoding == position_encoding::half_float) {
+        return glm::mat3(glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(center, 1.0f));
+    }
+    return glm::mat3(glm::vec3(size.x, 0.0f, 0.0f), glm::vec3(0.0f, size.y, 0.0f), glm::vec3(min, 1.0f));
+}
+
+}
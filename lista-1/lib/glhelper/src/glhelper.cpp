@@ -1,15 +1,19 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <initializer_list>
 #include <ios>
 #include <iostream>
+#include <limits>
+#include <span>
 #include <string>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <glhelper/glhelper.hpp>
+#include <glhelper/uniform_buffer.hpp>
 #include <vector>
 
 namespace glh {
@@ -29,12 +33,12 @@ void glfw_error_callback(int code, const char* desc) {
 }
 
 void glfw_frambuffer_size_callback(GLFWwindow* window, int width, int height) {
-    glViewport(0, 0, width, height);
+    state().viewport(0, 0, width, height);
 }
 
 void glfw_frambuffer_size_callback_square(GLFWwindow* window, int width, int height) {
     int min = std::min(width, height);
-    glViewport((min == height) * (width - height) / 2, (min == width) * (height - width) / 2, min, min);
+    state().viewport((min == height) * (width - height) / 2, (min == width) * (height - width) / 2, min, min);
 }
 
 GLFWwindow* create_window(std::string title, GLint width, GLint height) {
@@ -89,6 +93,10 @@ GLuint create_shader_program(std::initializer_list<GLuint> shaders, bool delete_
         terminate();
     }
 
+    // shared blocks, see glh/uniform_buffer.hpp
+    bind_uniform_block(program, "frame", FRAME_BINDING);
+    bind_uniform_block(program, "material", MATERIAL_BINDING);
+
     if (delete_shaders) {
         for (GLuint shader : shaders) {
             glDeleteShader(shader);
@@ -99,41 +107,85 @@ GLuint create_shader_program(std::initializer_list<GLuint> shaders, bool delete_
 }
 
 GLuint create_vao(const std::vector<GLfloat>& vertices, const std::vector<GLuint>& indices) {
-    GLuint vao;
-    glGenVertexArrays(1, &vao);
-    glBindVertexArray(vao);
-    
-    GLuint vbo;
-    glGenBuffers(1, &vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat), (GLvoid*) 0);
-    glEnableVertexAttribArray(0);
-
-    if (!indices.empty()) {
-        GLuint ebo;
-        glGenBuffers(1, &ebo);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLfloat), indices.data(), GL_STATIC_DRAW);
+    return create_vao<vertex_layout<attributes::vec2>>(vertices, indices);
+}
+
+GLuint create_vao(const std::vector<GLfloat>& vertices) {
+    return create_vao(vertices, {});
+}
+
+GLuint create_index_buffer(const GLvoid* indices, GLsizeiptr indices_size) {
+    GLuint ebo = names().acquire(object_kind::buffer);
+    state().bind_buffer(GL_COPY_WRITE_BUFFER, ebo);
+    glBufferData(GL_COPY_WRITE_BUFFER, indices_size, indices, GL_STATIC_DRAW);
+    state().bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+    return ebo;
+}
+
+GLenum index_type(std::span<const GLuint> indices) {
+    GLuint max = indices.empty() ? 0 : *std::max_element(indices.begin(), indices.end());
+
+    if (max <= std::numeric_limits<GLubyte>::max()) return GL_UNSIGNED_BYTE;
+    if (max <= std::numeric_limits<GLushort>::max()) return GL_UNSIGNED_SHORT;
+    return GL_UNSIGNED_INT;
+}
+
+GLsizei index_size(GLenum index_type) {
+    switch (index_type) {
+        case GL_UNSIGNED_BYTE:  return sizeof(GLubyte);
+        case GL_UNSIGNED_SHORT: return sizeof(GLushort);
+        default:                return sizeof(GLuint);
+    }
+}
+
+template <typename T>
+static void pack(std::span<const GLuint> indices, std::vector<GLubyte>& packed) {
+    T* out = reinterpret_cast<T*>(packed.data());
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        out[i] = static_cast<T>(indices[i]);
     }
+}
+
+std::vector<GLubyte> pack_indices(std::span<const GLuint> indices, GLenum index_type) {
+    std::vector<GLubyte> packed(indices.size() * index_size(index_type));
 
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    if (!indices.empty()) {
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    switch (index_type) {
+        case GL_UNSIGNED_BYTE:  pack<GLubyte>(indices, packed); break;
+        case GL_UNSIGNED_SHORT: pack<GLushort>(indices, packed); break;
+        default:                pack<GLuint>(indices, packed); break;
     }
 
-    return vao;
+    return packed;
+}
+
+void draw(const mesh& mesh, GLenum mode) {
+    state().bind_vertex_array(mesh.vao);
+    glDrawElements(mode, mesh.count, mesh.index_type, (GLvoid*) 0);
+}
+
+// shape functions
+namespace shapes {
+
+void transform(std::initializer_list<std::reference_wrapper<shape>> shapes, const affine& m) {
+    glm::mat3 matrix = to_mat3(m);
+    for (shape& s : shapes) {
+        transform(s, matrix);
+    }
 }
 
-GLuint create_vao(std::vector<GLfloat>& vertices) {
-    std::vector<GLuint> dummy{};
-    return create_vao(vertices, dummy);
+void bake(std::span<shape> shapes) {
+    std::vector<kernels::transform_job> jobs;
+    jobs.reserve(shapes.size());
+    for (shape& s : shapes) {
+        if (is_baked(s)) continue;
+
+        jobs.push_back({s.vertices.data(), s.vertices.size() / 2, 2, to_affine(s.transform)});
+        s.transform = glm::mat3(1.0f);
+    }
+
+    kernels::transform(jobs.data(), jobs.size());
 }
 
-GLuint create_vao(shape& shape) {
-    return create_vao(shape.vertices, shape.indices);
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/index_cache.hpp>
+
+namespace glh {
+
+// FNV-1a over the index values
+static std::uint64_t hash(std::span<const GLuint> indices) {
+    std::uint64_t result = 14695981039346656037ull;
+    for (GLuint index : indices) {
+        result = (result ^ index) * 1099511628211ull;
+    }
+    return result;
+}
+
+index_cache::~index_cache() {
+    // meshes still using an index buffer keep it alive
+    for (const entry& entry : _entries) {
+        names().retire(object_kind::buffer, entry.ebo);
+    }
+}
+
+index_cache::entry index_cache::acquire(topology_key key, std::span<const GLuint> indices) {
+    auto it = _by_key.find(key);
+    if (it != _by_key.end()) {
+        ++_hits;
+        return _entries[it->second];
+    }
+
+    // the same list may already be cached without a key
+    std::size_t slot = find(indices);
+    _by_key.emplace(key, slot);
+    return _entries[slot];
+}
+
+index_cache::entry index_cache::acquire(std::span<const GLuint> indices) {
+    return _entries[find(indices)];
+}
+
+std::size_t index_cache::find(std::span<const GLuint> indices) {
+    auto& bucket = _by_hash[hash(indices)];
+
+    for (const auto& [stored, slot] : bucket) {
+        if (std::equal(stored.begin(), stored.end(), indices.begin(), indices.end())) {
+            ++_hits;
+            return slot;
+        }
+    }
+
+    std::size_t slot = upload(indices);
+    bucket.emplace_back(std::vector<GLuint>(indices.begin(), indices.end()), slot);
+    return slot;
+}
+
+std::size_t index_cache::upload(std::span<const GLuint> indices) {
+    GLenum type = index_type(indices);
+    std::vector<GLubyte> packed = pack_indices(indices, type);
+
+    _entries.push_back({create_index_buffer(packed.data(), packed.size()), (GLsizei) indices.size(), type});
+    _bytes += packed.size();
+
+    return _entries.size() - 1;
+}
+
+}
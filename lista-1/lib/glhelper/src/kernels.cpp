@@ -0,0 +1,154 @@
+#include <cstddef>
+
+#include <glad/glad.h>
+
+#include <glhelper/kernels.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GLH_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC accepts every intrinsic without per-function target flags
+#define GLH_TARGET(isa)
+#else
+#define GLH_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace glh::kernels {
+
+namespace {
+
+void transform_scalar(GLfloat* xy, std::size_t count, std::size_t stride, const affine& m) {
+    for (std::size_t i = 0; i < count; ++i, xy += stride) {
+        GLfloat x = xy[0];
+        GLfloat y = xy[1];
+
+        xy[0] = m.a * x + m.b * y + m.c;
+        xy[1] = m.d * x + m.e * y + m.f;
+    }
+}
+
+#ifdef GLH_X86
+
+// with v = (x0, y0, x1, y1) and its pairwise swap s = (y0, x0, y1, x1)
+// the result is v * (a, e, a, e) + s * (b, d, b, d) + (c, f, c, f)
+
+GLH_TARGET("sse2")
+void transform_sse2(GLfloat* xy, std::size_t count, const affine& m) {
+    const __m128 diagonal = _mm_setr_ps(m.a, m.e, m.a, m.e);
+    const __m128 cross    = _mm_setr_ps(m.b, m.d, m.b, m.d);
+    const __m128 offset   = _mm_setr_ps(m.c, m.f, m.c, m.f);
+
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128 v = _mm_loadu_ps(xy + 2 * i);
+        __m128 s = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+
+        v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v, diagonal), _mm_mul_ps(s, cross)), offset);
+        _mm_storeu_ps(xy + 2 * i, v);
+    }
+
+    transform_scalar(xy + 2 * i, count - i, 2, m);
+}
+
+GLH_TARGET("avx2,fma")
+void transform_avx2(GLfloat* xy, std::size_t count, const affine& m) {
+    const __m256 diagonal = _mm256_setr_ps(m.a, m.e, m.a, m.e, m.a, m.e, m.a, m.e);
+    const __m256 cross    = _mm256_setr_ps(m.b, m.d, m.b, m.d, m.b, m.d, m.b, m.d);
+    const __m256 offset   = _mm256_setr_ps(m.c, m.f, m.c, m.f, m.c, m.f, m.c, m.f);
+
+    // two independent vectors per iteration to hide the FMA latency
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 v0 = _mm256_loadu_ps(xy + 2 * i);
+        __m256 v1 = _mm256_loadu_ps(xy + 2 * i + 8);
+        __m256 s0 = _mm256_permute_ps(v0, _MM_SHUFFLE(2, 3, 0, 1));
+        __m256 s1 = _mm256_permute_ps(v1, _MM_SHUFFLE(2, 3, 0, 1));
+
+        v0 = _mm256_fmadd_ps(v0, diagonal, _mm256_fmadd_ps(s0, cross, offset));
+        v1 = _mm256_fmadd_ps(v1, diagonal, _mm256_fmadd_ps(s1, cross, offset));
+
+        _mm256_storeu_ps(xy + 2 * i, v0);
+        _mm256_storeu_ps(xy + 2 * i + 8, v1);
+    }
+
+    for (; i + 4 <= count; i += 4) {
+        __m256 v = _mm256_loadu_ps(xy + 2 * i);
+        __m256 s = _mm256_permute_ps(v, _MM_SHUFFLE(2, 3, 0, 1));
+
+        v = _mm256_fmadd_ps(v, diagonal, _mm256_fmadd_ps(s, cross, offset));
+        _mm256_storeu_ps(xy + 2 * i, v);
+    }
+
+    transform_scalar(xy + 2 * i, count - i, 2, m);
+}
+
+#endif
+
+isa detect() {
+#ifdef GLH_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    bool sse2 = info[3] & (1 << 26);
+    bool fma = info[2] & (1 << 12);
+    bool os_saves_avx = (info[2] & (1 << 27)) && (_xgetbv(0) & 6) == 6;
+
+    bool avx2 = false;
+    if (max_leaf >= 7 && fma && os_saves_avx) {
+        __cpuidex(info, 7, 0);
+        avx2 = info[1] & (1 << 5);
+    }
+#else
+    __builtin_cpu_init();
+    bool sse2 = __builtin_cpu_supports("sse2");
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+
+    if (avx2) return isa::avx2;
+    if (sse2) return isa::sse2;
+#endif
+
+    return isa::scalar;
+}
+
+void dispatch(isa target, GLfloat* xy, std::size_t count, std::size_t stride, const affine& m) {
+    // the vector kernels only handle tightly packed pairs
+    if (stride != 2) {
+        return transform_scalar(xy, count, stride, m);
+    }
+
+    switch (target) {
+#ifdef GLH_X86
+        case isa::avx2: return transform_avx2(xy, count, m);
+        case isa::sse2: return transform_sse2(xy, count, m);
+#endif
+        default:        return transform_scalar(xy, count, stride, m);
+    }
+}
+
+}
+
+isa selected() {
+    static const isa detected = detect();
+    return detected;
+}
+
+void transform(GLfloat* xy, std::size_t count, std::size_t stride, const affine& m) {
+    dispatch(selected(), xy, count, stride, m);
+}
+
+void transform(const transform_job* jobs, std::size_t count) {
+    isa target = selected();
+    for (std::size_t i = 0; i < count; ++i) {
+        dispatch(target, jobs[i].xy, jobs[i].count, jobs[i].stride, jobs[i].m);
+    }
+}
+
+}
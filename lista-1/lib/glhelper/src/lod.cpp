@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/lod.hpp>
+
+namespace glh {
+
+namespace lod {
+
+static constexpr GLuint MIN_SEGMENTS = 6;
+static constexpr GLuint MAX_SEGMENTS = 1024;
+
+GLuint segments(GLfloat radius, GLfloat tolerance, GLfloat sweep) {
+    GLfloat fraction = std::clamp(sweep / 360.0f, 0.0f, 1.0f);
+    GLuint min = std::max<GLuint>(std::ceil(MIN_SEGMENTS * fraction), 1);
+    if (radius <= tolerance) return min;
+
+    // a chord spanning angle a misses the arc by radius * (1 - cos(a / 2))
+    GLfloat angle = 2.0f * std::acos(1.0f - tolerance / radius);
+    GLfloat count = std::ceil(fraction * 2.0f * std::numbers::pi / angle);
+
+    return std::clamp<GLuint>(count, min, MAX_SEGMENTS);
+}
+
+GLfloat projected_radius(const glm::mat4& projection, GLfloat radius, GLint viewport_width, GLint viewport_height) {
+    glm::vec2 half{viewport_width / 2.0f, viewport_height / 2.0f};
+
+    // the radius along each axis, the longer one bounds the error
+    glm::vec2 x = glm::vec2(projection * glm::vec4(radius, 0.0f, 0.0f, 0.0f)) * half;
+    glm::vec2 y = glm::vec2(projection * glm::vec4(0.0f, radius, 0.0f, 0.0f)) * half;
+
+    return std::max(glm::length(x), glm::length(y));
+}
+
+GLuint level(GLuint segments) {
+    GLuint power = 4;
+    while (true) {
+        if (segments <= power) return power;
+        if (segments <= power / 2 * 3) return power / 2 * 3;
+        if (power >= MAX_SEGMENTS) return MAX_SEGMENTS;
+        power *= 2;
+    }
+}
+
+}
+
+circle_lod::circle_lod(GLfloat radius, GLfloat x, GLfloat y, GLfloat tolerance, GLfloat hysteresis)
+    : _radius(radius), _x(x), _y(y), _tolerance(tolerance), _hysteresis(hysteresis) {}
+
+const mesh& circle_lod::select(const glm::mat4& projection, GLint viewport_width, GLint viewport_height) {
+    GLfloat radius = lod::projected_radius(projection, _radius, viewport_width, viewport_height);
+    GLuint wanted = lod::level(lod::segments(radius, _tolerance));
+
+    if (_segments == 0 || wanted > _segments) {
+        _segments = wanted;
+    } else if (wanted < _segments) {
+        // only coarsen once the circle could shrink by the hysteresis fraction and still fit
+        GLuint padded = lod::level(lod::segments(radius * (1.0f + _hysteresis), _tolerance));
+        if (padded < _segments) _segments = padded;
+    }
+
+    auto it = std::find_if(_levels.begin(), _levels.end(), [this](const auto& level) {
+        return level.first == _segments;
+    });
+    if (it != _levels.end()) return it->second;
+
+    _levels.emplace_back(_segments, create_mesh(shapes::make_polygon(_radius, _segments, _x, _y)));
+    return _levels.back().second;
+}
+
+void circle_lod::draw(const glm::mat4& projection, GLint viewport_width, GLint viewport_height) {
+    glh::draw(select(projection, viewport_width, viewport_height));
+}
+
+}
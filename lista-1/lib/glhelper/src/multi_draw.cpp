@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/multi_draw.hpp>
+
+namespace glh {
+
+multi_draw::multi_draw(bool allow_indirect) : _indirect(allow_indirect && GLAD_GL_VERSION_4_3) {}
+
+void multi_draw::add(GLsizei count, GLuint first, GLint base_vertex) {
+    if (count <= 0) return;
+
+    _counts.push_back(count);
+    _firsts.push_back(first);
+    _base_vertices.push_back(base_vertex);
+}
+
+void multi_draw::clear() {
+    _counts.clear();
+    _firsts.clear();
+    _base_vertices.clear();
+}
+
+void multi_draw::draw(GLenum mode, GLenum index_type) {
+    if (_counts.empty()) return;
+
+    if (_indirect) {
+        draw_indirect(mode, index_type);
+        return;
+    }
+
+    GLsizei draw_count = _counts.size();
+
+    if (index_type == GL_NONE) {
+        _first_vertices.assign(_firsts.begin(), _firsts.end());
+        glMultiDrawArrays(mode, _first_vertices.data(), _counts.data(), draw_count);
+        return;
+    }
+
+    GLsizei size = index_size(index_type);
+    _offsets.resize(draw_count);
+    for (GLsizei i = 0; i < draw_count; ++i) {
+        _offsets[i] = (const GLvoid*) (std::uintptr_t) (_firsts[i] * size);
+    }
+
+    glMultiDrawElementsBaseVertex(mode, _counts.data(), index_type, _offsets.data(), draw_count,
+                                  _base_vertices.data());
+}
+
+void multi_draw::draw_indirect(GLenum mode, GLenum index_type) {
+    GLsizei draw_count = _counts.size();
+    bool indexed = index_type != GL_NONE;
+    GLsizeiptr stride = indexed ? sizeof(elements_command) : sizeof(arrays_command);
+
+    _commands.resize(draw_count * stride);
+    for (GLsizei i = 0; i < draw_count; ++i) {
+        if (indexed) {
+            elements_command command{(GLuint) _counts[i], 1, _firsts[i], _base_vertices[i], 0};
+            std::memcpy(_commands.data() + i * stride, &command, stride);
+        } else {
+            arrays_command command{(GLuint) _counts[i], 1, _firsts[i], 0};
+            std::memcpy(_commands.data() + i * stride, &command, stride);
+        }
+    }
+
+    if (!_buffer) {
+        _buffer = make_buffer();
+    }
+
+    _capacity = std::max<GLsizeiptr>(_capacity, 256);
+    while (_capacity < (GLsizeiptr) _commands.size()) {
+        _capacity *= 2;
+    }
+
+    // orphan the storage the previous draw may still be reading
+    state().bind_buffer(GL_DRAW_INDIRECT_BUFFER, _buffer);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, _capacity, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, _commands.size(), _commands.data());
+
+    if (indexed) {
+        glMultiDrawElementsIndirect(mode, index_type, (const GLvoid*) 0, draw_count, 0);
+    } else {
+        glMultiDrawArraysIndirect(mode, (const GLvoid*) 0, draw_count, 0);
+    }
+}
+
+}
@@ -0,0 +1,206 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/optimize.hpp>
+
+namespace glh {
+
+namespace optimize {
+
+static constexpr GLuint UNUSED = std::numeric_limits<GLuint>::max();
+
+GLfloat acmr(std::span<const GLuint> indices, GLuint cache_size) {
+    if (indices.size() < 3) return 0.0f;
+
+    // a vertex is cached if it entered the FIFO less than cache_size misses ago
+    std::unordered_map<GLuint, std::size_t> entered;
+    std::size_t misses = 0;
+
+    for (GLuint index : indices) {
+        auto it = entered.find(index);
+        if (it == entered.end() || misses - it->second >= cache_size) {
+            entered[index] = misses++;
+        }
+    }
+
+    return (GLfloat) misses / (indices.size() / 3);
+}
+
+std::size_t weld(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices, GLuint components, GLfloat epsilon) {
+    std::size_t count = vertices.size() / components;
+
+    // vertices are bucketed by the hash of their snapped components,
+    // a bucket may hold distinct vertices so candidates are compared in full
+    auto snap = [epsilon](GLfloat value) {
+        return (std::int64_t) std::llround(value / epsilon);
+    };
+    auto hash = [&](const GLfloat* vertex) {
+        std::uint64_t result = 14695981039346656037ull;
+        for (GLuint i = 0; i < components; ++i) {
+            result = (result ^ (std::uint64_t) snap(vertex[i])) * 1099511628211ull;
+        }
+        return result;
+    };
+    auto same = [&](const GLfloat* a, const GLfloat* b) {
+        for (GLuint i = 0; i < components; ++i) {
+            if (snap(a[i]) != snap(b[i])) return false;
+        }
+        return true;
+    };
+
+    std::unordered_multimap<std::uint64_t, GLuint> buckets;
+    buckets.reserve(count);
+    std::vector<GLuint> remap(count);
+    GLuint kept = 0;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const GLfloat* vertex = vertices.data() + i * components;
+        std::uint64_t key = hash(vertex);
+
+        remap[i] = UNUSED;
+        auto [begin, end] = buckets.equal_range(key);
+        for (auto it = begin; it != end; ++it) {
+            if (same(vertex, vertices.data() + it->second * components)) {
+                remap[i] = it->second;
+                break;
+            }
+        }
+
+        if (remap[i] == UNUSED) {
+            // compact in place, kept never passes i
+            std::copy_n(vertex, components, vertices.data() + kept * components);
+            buckets.emplace(key, kept);
+            remap[i] = kept++;
+        }
+    }
+
+    vertices.resize(kept * components);
+    for (GLuint& index : indices) {
+        index = remap[index];
+    }
+
+    return kept;
+}
+
+void reorder_triangles(std::vector<GLuint>& indices, std::size_t vertex_count, GLuint cache_size) {
+    std::size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0) return;
+
+    // vertex to triangle adjacency in compressed rows
+    std::vector<GLuint> live(vertex_count, 0);
+    for (GLuint index : indices) {
+        ++live[index];
+    }
+
+    std::vector<std::size_t> offsets(vertex_count + 1, 0);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+
+    std::vector<GLuint> adjacency(indices.size());
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        adjacency[fill[indices[i]]++] = i / 3;
+    }
+
+    std::vector<std::size_t> cache_time(vertex_count, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<GLuint> dead_end;
+    std::vector<GLuint> candidates;
+    std::vector<GLuint> output;
+    output.reserve(indices.size());
+
+    std::size_t time = cache_size + 1;
+    std::size_t cursor = 0;
+    GLint fan = 0;
+
+    while (fan >= 0) {
+        candidates.clear();
+
+        for (std::size_t i = offsets[fan]; i < offsets[fan + 1]; ++i) {
+            GLuint triangle = adjacency[i];
+            if (emitted[triangle]) continue;
+
+            for (std::size_t corner = 0; corner < 3; ++corner) {
+                GLuint v = indices[triangle * 3 + corner];
+                output.push_back(v);
+                dead_end.push_back(v);
+                candidates.push_back(v);
+                --live[v];
+
+                if (time - cache_time[v] > cache_size) {
+                    cache_time[v] = time++;
+                }
+            }
+
+            emitted[triangle] = true;
+        }
+
+        // the candidate that will still be cached after its remaining triangles is preferred,
+        // the one that entered the cache earliest among those
+        GLint best = -1;
+        std::size_t priority = 0;
+        for (GLuint v : candidates) {
+            if (live[v] == 0) continue;
+
+            std::size_t p = 0;
+            if (time - cache_time[v] + 2 * live[v] <= cache_size) {
+                p = time - cache_time[v];
+            }
+
+            if (best < 0 || p > priority) {
+                best = v;
+                priority = p;
+            }
+        }
+
+        if (best < 0) {
+            // dead end, back up to a recent vertex that still has triangles
+            while (!dead_end.empty() && best < 0) {
+                GLuint v = dead_end.back();
+                dead_end.pop_back();
+                if (live[v] > 0) best = v;
+            }
+
+            while (best < 0 && cursor < vertex_count) {
+                if (live[cursor] > 0) best = cursor;
+                ++cursor;
+            }
+        }
+
+        fan = best;
+    }
+
+    indices = std::move(output);
+}
+
+void reorder_vertices(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices, GLuint components) {
+    std::size_t count = vertices.size() / components;
+
+    std::vector<GLuint> remap(count, UNUSED);
+    std::vector<GLfloat> reordered;
+    reordered.reserve(vertices.size());
+
+    GLuint next = 0;
+    for (GLuint& index : indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = next++;
+            reordered.insert(reordered.end(), vertices.begin() + index * components,
+                             vertices.begin() + (index + 1) * components);
+        }
+        index = remap[index];
+    }
+
+    vertices = std::move(reordered);
+}
+
+}
+
+}
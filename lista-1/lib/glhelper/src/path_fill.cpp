@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/path_fill.hpp>
+
+namespace glh {
+
+path_fill::path_fill(GLsizei capacity) : _capacity(std::max(capacity, 4)) {
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_vbo);
+
+    state().bind_vertex_array(_vao);
+    state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(GL_ARRAY_BUFFER, _capacity * 2 * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+    vertex_layout<attributes::vec2>::enable();
+
+    state().bind_vertex_array(0);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+}
+
+path_fill::~path_fill() {
+    state().delete_vertex_arrays(1, &_vao);
+    state().delete_buffers(1, &_vbo);
+}
+
+void path_fill::set_path(std::span<const GLfloat> outline) {
+    _vertices.assign(outline.begin(), outline.end());
+    _firsts.assign(1, 0);
+    _counts.assign(1, outline.size() / 2);
+    upload();
+}
+
+void path_fill::set_path(std::span<const std::vector<GLfloat>> contours) {
+    _vertices.clear();
+    _firsts.clear();
+    _counts.clear();
+
+    for (const auto& contour : contours) {
+        _firsts.push_back(_vertices.size() / 2);
+        _counts.push_back(contour.size() / 2);
+        _vertices.insert(_vertices.end(), contour.begin(), contour.end());
+    }
+    upload();
+}
+
+void path_fill::upload() {
+    // every fan lies inside the bounding box, so covering it reaches every stencilled pixel
+    GLfloat min_x = std::numeric_limits<GLfloat>::max();
+    GLfloat min_y = std::numeric_limits<GLfloat>::max();
+    GLfloat max_x = std::numeric_limits<GLfloat>::lowest();
+    GLfloat max_y = std::numeric_limits<GLfloat>::lowest();
+
+    for (std::size_t i = 0; i + 1 < _vertices.size(); i += 2) {
+        min_x = std::min(min_x, _vertices[i]);
+        max_x = std::max(max_x, _vertices[i]);
+        min_y = std::min(min_y, _vertices[i + 1]);
+        max_y = std::max(max_y, _vertices[i + 1]);
+    }
+
+    _vertices.insert(_vertices.end(), {min_x, min_y, max_x, min_y, min_x, max_y, max_x, max_y});
+
+    GLsizei count = _vertices.size() / 2;
+
+    state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+    if (count > _capacity) {
+        // orphan the old storage
+        while (_capacity < count) {
+            _capacity *= 2;
+        }
+        glBufferData(GL_ARRAY_BUFFER, _capacity * 2 * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, _vertices.size() * sizeof(GLfloat), _vertices.data());
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+}
+
+void path_fill::fill(fill_rule rule) const {
+    if (_firsts.empty()) return;
+
+    state().bind_vertex_array(_vao);
+
+    // stencil pass, fans are counted without touching the color buffer
+    GLboolean stencil = glIsEnabled(GL_STENCIL_TEST);
+    glEnable(GL_STENCIL_TEST);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glStencilFunc(GL_ALWAYS, 0, 0xFF);
+
+    GLuint mask = 0xFF;
+    if (rule == fill_rule::even_odd) {
+        // only the lowest bit flips, so it holds the parity
+        mask = 0x01;
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+    } else {
+        // counterclockwise triangles add one winding, clockwise ones remove it
+        glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INCR_WRAP);
+        glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
+    }
+    glStencilMask(mask);
+
+    glMultiDrawArrays(GL_TRIANGLE_FAN, _firsts.data(), _counts.data(), _firsts.size());
+
+    // cover pass, draws where the stencil is set and zeroes it again
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glStencilMask(0xFF);
+    glStencilFunc(GL_NOTEQUAL, 0, mask);
+    glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+
+    glDrawArrays(GL_TRIANGLE_STRIP, _vertices.size() / 2 - 4, 4);
+
+    if (!stencil) glDisable(GL_STENCIL_TEST);
+}
+
+}
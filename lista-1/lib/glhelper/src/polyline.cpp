@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/polyline.hpp>
+
+namespace glh {
+
+// the first and last points are stored twice, so the end segments see themselves as neighbors
+static constexpr GLsizei PADDING = 2;
+
+// points are read from the buffer at four consecutive offsets, one per instance
+static void attach(GLuint vbo) {
+    state().bind_buffer(GL_ARRAY_BUFFER, vbo);
+    for (GLuint i = 0; i < 4; ++i) {
+        glVertexAttribPointer(i, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(GLfloat),
+                              (GLvoid*) (std::uintptr_t) (i * 2 * sizeof(GLfloat)));
+        glEnableVertexAttribArray(i);
+        glVertexAttribDivisor(i, 1);
+    }
+}
+
+polyline::polyline(GLsizei capacity) : _capacity(std::max(capacity, 2) + PADDING) {
+    _program = create_shader_program({
+        compile_shader(&shader::polyline_vertex, GL_VERTEX_SHADER),
+        compile_shader(&shader::polyline_fragment, GL_FRAGMENT_SHADER)
+    });
+
+    _projection_location = glGetUniformLocation(_program, "projection");
+    _viewport_location   = glGetUniformLocation(_program, "viewport");
+    _width_location      = glGetUniformLocation(_program, "width");
+    _join_location       = glGetUniformLocation(_program, "join");
+    _color_location      = glGetUniformLocation(_program, "line_color");
+
+    set_projection(glm::mat4(1.0f));
+    set_width(2.0f);
+    set_join(line_join::round);
+    set_color(1.0f, 0.84f, 0.1f);
+
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_vbo);
+
+    state().bind_vertex_array(_vao);
+    state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(GL_ARRAY_BUFFER, _capacity * 2 * sizeof(GLfloat), NULL, GL_STATIC_DRAW);
+    attach(_vbo);
+
+    state().bind_vertex_array(0);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+}
+
+polyline::~polyline() {
+    state().delete_vertex_arrays(1, &_vao);
+    state().delete_buffers(1, &_vbo);
+    state().delete_program(_program);
+}
+
+void polyline::set_points(std::span<const GLfloat> points) {
+    _count = points.size() / 2;
+    if (_count < 2) {
+        _count = 0;
+        return;
+    }
+
+    GLsizei size = _count + PADDING;
+
+    state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+    if (size > _capacity) {
+        // orphan the old storage
+        while (_capacity < size) {
+            _capacity *= 2;
+        }
+        glBufferData(GL_ARRAY_BUFFER, _capacity * 2 * sizeof(GLfloat), NULL, GL_STATIC_DRAW);
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER, 0, 2 * sizeof(GLfloat), points.data());
+    glBufferSubData(GL_ARRAY_BUFFER, 2 * sizeof(GLfloat), points.size() * sizeof(GLfloat), points.data());
+    glBufferSubData(GL_ARRAY_BUFFER, (size - 1) * 2 * sizeof(GLfloat), 2 * sizeof(GLfloat),
+                    points.data() + points.size() - 2);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+}
+
+void polyline::set_projection(const glm::mat4& projection) const {
+    state().use_program(_program);
+    glUniformMatrix4fv(_projection_location, 1, GL_FALSE, glm::value_ptr(projection));
+}
+
+void polyline::set_width(GLfloat width) const {
+    state().use_program(_program);
+    glUniform1f(_width_location, width);
+}
+
+void polyline::set_join(line_join join) const {
+    state().use_program(_program);
+    glUniform1i(_join_location, (GLint) join);
+}
+
+void polyline::set_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a) const {
+    state().use_program(_program);
+    glUniform4f(_color_location, r, g, b, a);
+}
+
+void polyline::draw() const {
+    if (_count < 2) return;
+
+    // extrusion happens in pixels of the current viewport
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    state().use_program(_program);
+    glUniform2f(_viewport_location, viewport[2], viewport[3]);
+    state().bind_vertex_array(_vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, _count - 1);
+
+    if (!blend) glDisable(GL_BLEND);
+}
+
+}
@@ -0,0 +1,63 @@
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/procedural.hpp>
+
+namespace glh {
+
+procedural::procedural() {
+    _program = create_shader_program({
+        compile_shader(&shader::procedural_vertex, GL_VERTEX_SHADER),
+        compile_shader(&shader::basic_fragment_uniform, GL_FRAGMENT_SHADER)
+    });
+
+    _kind_location   = glGetUniformLocation(_program, "kind");
+    _radius_location = glGetUniformLocation(_program, "radius");
+    _count_location  = glGetUniformLocation(_program, "count");
+    _center_location = glGetUniformLocation(_program, "center");
+    _color_location  = glGetUniformLocation(_program, "uniform_color");
+
+    // the core profile refuses to draw without a VAO, even if it has no attributes
+    glGenVertexArrays(1, &_vao);
+
+    state().use_program(_program);
+    glUniform3f(_color_location, 1.0f, 0.84f, 0.1f);
+    state().use_program(0);
+}
+
+procedural::~procedural() {
+    state().delete_vertex_arrays(1, &_vao);
+    state().delete_program(_program);
+}
+
+void procedural::use() const {
+    state().use_program(_program);
+    state().bind_vertex_array(_vao);
+}
+
+void procedural::set_color(GLfloat r, GLfloat g, GLfloat b) const {
+    glUniform3f(_color_location, r, g, b);
+}
+
+void procedural::draw_polygon(GLfloat radius, GLuint sides, GLfloat x, GLfloat y) const {
+    draw(polygon, radius, sides, x, y, GL_TRIANGLES);
+}
+
+void procedural::draw_star(GLfloat radius, GLuint points, GLfloat x, GLfloat y) const {
+    draw(star, radius, points, x, y, GL_TRIANGLES);
+}
+
+void procedural::draw_spiral(GLfloat radius, GLuint loops, GLfloat x, GLfloat y) const {
+    draw(spiral, radius, loops, x, y, GL_LINE_STRIP);
+}
+
+void procedural::draw(kind kind, GLfloat radius, GLuint count, GLfloat x, GLfloat y, GLenum mode) const {
+    glUniform1i(_kind_location, kind);
+    glUniform1f(_radius_location, radius);
+    glUniform1i(_count_location, count);
+    glUniform2f(_center_location, x, y);
+
+    glDrawArrays(mode, 0, vertex_count(kind, count));
+}
+
+}
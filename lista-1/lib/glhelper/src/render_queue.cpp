@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/render_queue.hpp>
+
+namespace glh {
+
+uniform_set& uniform_set::set(GLint location, const GLfloat* data, GLsizei size, bool integer) {
+    auto it = std::find_if(_values.begin(), _values.end(), [location](const value& v) {
+        return v.location == location;
+    });
+    if (it == _values.end()) {
+        it = _values.insert(_values.end(), value{location});
+    }
+
+    it->size = size;
+    it->integer = integer;
+    std::copy_n(data, size, it->data.begin());
+    return *this;
+}
+
+uniform_set& uniform_set::set(GLint location, GLint value) {
+    GLfloat bits;
+    std::memcpy(&bits, &value, sizeof(value));
+    return set(location, &bits, 1, true);
+}
+
+uniform_set& uniform_set::set(GLint location, GLfloat value) {
+    return set(location, &value, 1);
+}
+
+uniform_set& uniform_set::set(GLint location, const glm::vec2& value) {
+    return set(location, glm::value_ptr(value), 2);
+}
+
+uniform_set& uniform_set::set(GLint location, const glm::vec3& value) {
+    return set(location, glm::value_ptr(value), 3);
+}
+
+uniform_set& uniform_set::set(GLint location, const glm::vec4& value) {
+    return set(location, glm::value_ptr(value), 4);
+}
+
+uniform_set& uniform_set::set(GLint location, const glm::mat3& value) {
+    return set(location, glm::value_ptr(value), 9);
+}
+
+uniform_set& uniform_set::set(GLint location, const glm::mat4& value) {
+    return set(location, glm::value_ptr(value), 16);
+}
+
+void uniform_set::apply() const {
+    for (const value& v : _values) {
+        const GLfloat* data = v.data.data();
+        switch (v.size) {
+            case 1:
+                if (v.integer) {
+                    GLint integer;
+                    std::memcpy(&integer, data, sizeof(integer));
+                    state().uniform(v.location, integer);
+                } else {
+                    state().uniform(v.location, data[0]);
+                }
+                break;
+            case 2:  state().uniform(v.location, glm::make_vec2(data)); break;
+            case 3:  state().uniform(v.location, glm::make_vec3(data)); break;
+            case 4:  state().uniform(v.location, glm::make_vec4(data)); break;
+            case 9:  state().uniform(v.location, glm::make_mat3(data)); break;
+            default: state().uniform(v.location, glm::make_mat4(data)); break;
+        }
+    }
+}
+
+std::uint64_t render_queue::make_key(GLubyte layer, GLuint program, GLuint vao, GLuint uniforms) {
+    // no uniforms wraps around to 0
+    return (std::uint64_t) layer << 56
+         | (std::uint64_t) (program & 0xFFFF) << 40
+         | (std::uint64_t) (vao & 0xFFFFFF) << 16
+         | (std::uint64_t) ((uniforms + 1) & 0xFFFF);
+}
+
+GLuint render_queue::add_uniforms(uniform_set uniforms) {
+    _uniforms.push_back(std::move(uniforms));
+    return _uniforms.size() - 1;
+}
+
+void render_queue::submit_keyed(std::uint64_t key, const draw_item& item) {
+    _entries.push_back({key, (GLuint) _items.size()});
+    _items.push_back(item);
+}
+
+void render_queue::submit(GLubyte layer, const draw_item& item) {
+    submit_keyed(make_key(layer, item.program, item.vao, item.uniforms), item);
+}
+
+void render_queue::submit(GLubyte layer, GLuint program, const mesh& mesh, GLuint uniforms, GLenum mode) {
+    draw_item item;
+    item.program = program;
+    item.vao = mesh.vao;
+    item.uniforms = uniforms;
+    item.mode = mode;
+    item.count = mesh.count;
+    item.index_type = mesh.index_type;
+    submit(layer, item);
+}
+
+// stable LSD radix sort on bytes, skipping the bytes every key shares
+void render_queue::sort() {
+    _scratch.resize(_entries.size());
+
+    for (int shift = 0; shift < 64; shift += 8) {
+        std::array<std::size_t, 256> counts{};
+        for (const entry& e : _entries) {
+            ++counts[(e.key >> shift) & 0xFF];
+        }
+        if (counts[(_entries.front().key >> shift) & 0xFF] == _entries.size()) continue;
+
+        std::size_t offset = 0;
+        for (std::size_t& count : counts) {
+            offset += std::exchange(count, offset);
+        }
+        for (const entry& e : _entries) {
+            _scratch[counts[(e.key >> shift) & 0xFF]++] = e;
+        }
+        _entries.swap(_scratch);
+    }
+}
+
+// primitives that can be concatenated without connecting the draws
+static bool mergeable(GLenum mode) {
+    return mode == GL_POINTS || mode == GL_LINES || mode == GL_TRIANGLES;
+}
+
+static bool same_state(const draw_item& a, const draw_item& b) {
+    return a.program == b.program && a.vao == b.vao && a.uniforms == b.uniforms && a.mode == b.mode
+        && a.index_type == b.index_type;
+}
+
+static bool adjacent(const draw_item& a, const draw_item& b) {
+    return mergeable(a.mode) && a.base_vertex == b.base_vertex && a.first + a.count == b.first;
+}
+
+static void issue(const draw_item& item) {
+    if (item.index_type == GL_NONE) {
+        glDrawArrays(item.mode, item.first, item.count);
+        return;
+    }
+
+    GLvoid* offset = (GLvoid*) (std::uintptr_t) (item.first * index_size(item.index_type));
+    if (item.base_vertex == 0) {
+        glDrawElements(item.mode, item.count, item.index_type, offset);
+    } else {
+        glDrawElementsBaseVertex(item.mode, item.count, item.index_type, offset, item.base_vertex);
+    }
+}
+
+void render_queue::flush() {
+    _submitted = _entries.size();
+    _batches = 0;
+    if (_entries.empty()) return;
+
+    sort();
+
+    GLuint program = 0;
+    GLuint uniforms = draw_item::NO_UNIFORMS;
+    bool first = true;
+
+    for (std::size_t i = 0; i < _entries.size();) {
+        draw_item batch = _items[_entries[i].item];
+
+        // ranges of the run of draws sharing the state, adjacent ones merged
+        _batch.clear();
+        for (++i; i < _entries.size() && same_state(batch, _items[_entries[i].item]); ++i) {
+            const draw_item& next = _items[_entries[i].item];
+            if (adjacent(batch, next)) {
+                batch.count += next.count;
+            } else {
+                _batch.add(batch.count, batch.first, batch.base_vertex);
+                batch.first = next.first;
+                batch.count = next.count;
+                batch.base_vertex = next.base_vertex;
+            }
+        }
+
+        state().use_program(batch.program);
+        state().bind_vertex_array(batch.vao);
+        // uniform sets are uploaded again when the program changes, each program has its own values
+        if (batch.uniforms != draw_item::NO_UNIFORMS && (first || batch.program != program || batch.uniforms != uniforms)) {
+            _uniforms[batch.uniforms].apply();
+        }
+        program = batch.program;
+        uniforms = batch.uniforms;
+        first = false;
+
+        if (_batch.size() == 0) {
+            issue(batch);
+        } else {
+            _batch.add(batch.count, batch.first, batch.base_vertex);
+            _batch.draw(batch.mode, batch.index_type);
+        }
+        ++_batches;
+    }
+
+    _items.clear();
+    _entries.clear();
+}
+
+}
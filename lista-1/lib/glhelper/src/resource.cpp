@@ -0,0 +1,94 @@
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/resource.hpp>
+#include <glhelper/state.hpp>
+
+namespace glh {
+
+name_pool::name_pool(GLsizei block_size) : _block_size(std::max(block_size, 1)) {}
+
+GLuint name_pool::acquire(object_kind kind) {
+    list& list = _lists[(std::size_t) kind];
+
+    if (list.names.empty()) {
+        list.names.resize(_block_size);
+        if (kind == object_kind::buffer) {
+            glGenBuffers(_block_size, list.names.data());
+        } else {
+            glGenVertexArrays(_block_size, list.names.data());
+        }
+        list.generated += _block_size;
+        // hand out the lowest names first
+        std::reverse(list.names.begin(), list.names.end());
+    }
+
+    GLuint name = list.names.back();
+    list.names.pop_back();
+    ++list.live;
+    return name;
+}
+
+void name_pool::release(object_kind kind, GLuint name) {
+    if (kind == object_kind::buffer) {
+        // frees the storage, the name stays valid
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, name);
+        glBufferData(GL_COPY_WRITE_BUFFER, 0, NULL, GL_STATIC_DRAW);
+        state().bind_buffer(GL_COPY_WRITE_BUFFER, 0);
+    } else {
+        reset_vertex_array(name);
+    }
+
+    list& list = _lists[(std::size_t) kind];
+    list.names.push_back(name);
+    --list.live;
+}
+
+void name_pool::retire(object_kind kind, GLuint name) {
+    if (kind == object_kind::buffer) {
+        state().delete_buffers(1, &name);
+    } else {
+        state().delete_vertex_arrays(1, &name);
+    }
+
+    list& list = _lists[(std::size_t) kind];
+    --list.live;
+}
+
+void name_pool::trim() {
+    list& buffers = _lists[(std::size_t) object_kind::buffer];
+    list& vertex_arrays = _lists[(std::size_t) object_kind::vertex_array];
+
+    state().delete_buffers(buffers.names.size(), buffers.names.data());
+    state().delete_vertex_arrays(vertex_arrays.names.size(), vertex_arrays.names.data());
+
+    buffers.names.clear();
+    vertex_arrays.names.clear();
+}
+
+void name_pool::reset_vertex_array(GLuint name) {
+    if (_max_attributes == 0) {
+        glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &_max_attributes);
+    }
+
+    // pointing the attributes at buffer 0 drops the VAO's references to its buffers
+    state().bind_vertex_array(name);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+    for (GLint i = 0; i < _max_attributes; ++i) {
+        glDisableVertexAttribArray(i);
+        glVertexAttribPointer(i, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+        glVertexAttribDivisor(i, 0);
+    }
+    state().bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    state().bind_vertex_array(0);
+}
+
+name_pool& names() {
+    static name_pool pool;
+    return pool;
+}
+
+}
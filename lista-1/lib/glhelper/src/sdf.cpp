@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <numbers>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/sdf.hpp>
+
+namespace glh {
+
+sdf_batch::sdf_batch(GLsizei capacity) : _capacity(std::max(capacity, 1)) {
+    _program = create_shader_program({
+        compile_shader(&shader::sdf_vertex, GL_VERTEX_SHADER),
+        compile_shader(&shader::sdf_fragment, GL_FRAGMENT_SHADER)
+    });
+
+    _projection_location = glGetUniformLocation(_program, "projection");
+    set_projection(glm::mat4(1.0f));
+
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_vbo);
+
+    state().bind_vertex_array(_vao);
+    state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(instance), NULL, GL_DYNAMIC_DRAW);
+    vertex_layout<attributes::vec4, attributes::vec4, attributes::vec4>::enable(0, 1);
+
+    state().bind_vertex_array(0);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+}
+
+sdf_batch::~sdf_batch() {
+    state().delete_vertex_arrays(1, &_vao);
+    state().delete_buffers(1, &_vbo);
+    state().delete_program(_program);
+}
+
+void sdf_batch::add_circle(GLfloat x, GLfloat y, GLfloat radius, rgba color) {
+    add(circle, x, y, radius, radius, 0, 0, 0, color);
+}
+
+void sdf_batch::add_rounded_rect(GLfloat x, GLfloat y, GLfloat width, GLfloat height, GLfloat corner_radius,
+                                 GLfloat angle, rgba color) {
+    corner_radius = std::min({corner_radius, width / 2, height / 2});
+    add(rounded_rect, x, y, width / 2, height / 2, 0, corner_radius, angle, color);
+}
+
+void sdf_batch::add_polygon(GLfloat x, GLfloat y, GLfloat radius, GLuint sides, GLfloat angle, rgba color) {
+    add(polygon, x, y, radius, radius, sides, 0, angle, color);
+}
+
+void sdf_batch::add_star(GLfloat x, GLfloat y, GLfloat radius, GLuint points, GLfloat angle, rgba color,
+                         GLfloat inner) {
+    add(star, x, y, radius, radius, points, inner, angle, color);
+}
+
+void sdf_batch::add(kind kind, GLfloat x, GLfloat y, GLfloat half_width, GLfloat half_height, GLfloat count,
+                    GLfloat parameter, GLfloat angle, const rgba& color) {
+    GLfloat radians = angle * std::numbers::pi / 180.0f;
+    _instances.push_back({{x, y, half_width, half_height}, {(GLfloat) kind, count, parameter, radians}, color});
+    _dirty = true;
+}
+
+void sdf_batch::clear() {
+    _instances.clear();
+    _dirty = true;
+}
+
+void sdf_batch::set_projection(const glm::mat4& projection) const {
+    state().use_program(_program);
+    glUniformMatrix4fv(_projection_location, 1, GL_FALSE, glm::value_ptr(projection));
+}
+
+void sdf_batch::draw() {
+    if (_dirty) {
+        state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+        if ((GLsizei) _instances.size() > _capacity) {
+            while (_capacity < (GLsizei) _instances.size()) {
+                _capacity *= 2;
+            }
+            glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(instance), NULL, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, _instances.size() * sizeof(instance), _instances.data());
+        state().bind_buffer(GL_ARRAY_BUFFER, 0);
+
+        _dirty = false;
+    }
+
+    GLboolean blend = glIsEnabled(GL_BLEND);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    state().use_program(_program);
+    state().bind_vertex_array(_vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, _instances.size());
+
+    if (!blend) glDisable(GL_BLEND);
+}
+
+}
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/sprite.hpp>
+
+namespace glh::sprites {
+
+bitmap make_bitmap(std::span<const std::string_view> rows, std::string_view key) {
+    bitmap result;
+    result.height = rows.size();
+    for (std::string_view row : rows) {
+        result.width = std::max<GLsizei>(result.width, row.size());
+    }
+
+    result.cells.assign(result.width * result.height, bitmap::empty);
+    for (GLsizei y = 0; y < result.height; ++y) {
+        for (GLsizei x = 0; x < (GLsizei) rows[y].size(); ++x) {
+            std::size_t index = key.find(rows[y][x]);
+            if (index != std::string_view::npos) {
+                result.cells[y * result.width + x] = index;
+            }
+        }
+    }
+
+    return result;
+}
+
+// skips whitespace and comments between header fields
+static void skip_ppm_space(std::istream& in) {
+    while (in) {
+        int c = in.peek();
+        if (c == '#') {
+            in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        } else if (std::isspace(c)) {
+            in.get();
+        } else {
+            break;
+        }
+    }
+}
+
+bitmap load_ppm(const std::string& path, std::vector<color>& palette, color transparent) {
+    std::ifstream in(path, std::ios::binary);
+
+    std::string magic;
+    GLsizei width = 0, height = 0;
+    int max_value = 0;
+
+    in >> magic;
+    skip_ppm_space(in);
+    in >> width;
+    skip_ppm_space(in);
+    in >> height;
+    skip_ppm_space(in);
+    in >> max_value;
+    in.get();
+
+    if (!in || (magic != "P6" && magic != "P3") || width <= 0 || height <= 0 || max_value <= 0 || max_value > 255) {
+        std::cerr << "Failed to load sprite, expected an 8-bit P3 or P6 image: " << path << std::endl;
+        terminate();
+    }
+
+    bitmap result{width, height, std::vector<GLubyte>(width * height, bitmap::empty)};
+    for (GLubyte& cell : result.cells) {
+        int rgb[3];
+        for (int& channel : rgb) {
+            if (magic == "P6") {
+                channel = in.get();
+            } else {
+                in >> channel;
+            }
+        }
+
+        if (!in) {
+            std::cerr << "Sprite image is truncated: " << path << std::endl;
+            terminate();
+        }
+
+        color c{(GLfloat) rgb[0] / max_value, (GLfloat) rgb[1] / max_value, (GLfloat) rgb[2] / max_value};
+        if (c == transparent) continue;
+
+        auto it = std::find(palette.begin(), palette.end(), c);
+        if (it == palette.end()) {
+            if (palette.size() >= bitmap::empty) {
+                std::cerr << "Sprite has more than " << (int) bitmap::empty << " colors: " << path << std::endl;
+                terminate();
+            }
+            it = palette.insert(palette.end(), c);
+        }
+
+        cell = it - palette.begin();
+    }
+
+    return result;
+}
+
+color_shape greedy_mesh(const bitmap& bitmap, std::span<const color> palette, GLfloat pixel_size,
+                        GLfloat left, GLfloat top) {
+    std::vector<bool> done(bitmap.cells.size());
+    shapes::color_shape_builder builder;
+
+    auto unmerged = [&](GLsizei x, GLsizei y, GLubyte value) {
+        return !done[y * bitmap.width + x] && bitmap.at(x, y) == value;
+    };
+
+    for (GLsizei y = 0; y < bitmap.height; ++y) {
+        for (GLsizei x = 0; x < bitmap.width; ++x) {
+            GLubyte value = bitmap.at(x, y);
+            if (value == bitmap::empty || done[y * bitmap.width + x]) continue;
+
+            // grow right as far as the run goes, then down while whole rows match
+            GLsizei width = 1;
+            while (x + width < bitmap.width && unmerged(x + width, y, value)) {
+                ++width;
+            }
+
+            GLsizei height = 1;
+            while (y + height < bitmap.height) {
+                bool row_matches = true;
+                for (GLsizei i = x; i < x + width && row_matches; ++i) {
+                    row_matches = unmerged(i, y + height, value);
+                }
+                if (!row_matches) break;
+                ++height;
+            }
+
+            for (GLsizei j = y; j < y + height; ++j) {
+                std::fill_n(done.begin() + j * bitmap.width + x, width, true);
+            }
+
+            builder.add_rectangle(left + x * pixel_size, top - (y + height) * pixel_size,
+                                  width * pixel_size, height * pixel_size, palette[value]);
+        }
+    }
+
+    return builder.build();
+}
+
+atlas::atlas(GLsizei width, GLsizei height) : _width(width), _height(height) {
+    std::vector<GLubyte> transparent(width * height * 4);
+
+    glGenTextures(1, &_texture);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, transparent.data());
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+atlas::~atlas() {
+    glDeleteTextures(1, &_texture);
+}
+
+atlas::region atlas::add(const bitmap& bitmap, std::span<const color> palette) {
+    // start a new shelf when the row is full
+    if (_shelf_x + bitmap.width + 1 > _width) {
+        _shelf_x = 0;
+        _shelf_y += _shelf_height;
+        _shelf_height = 0;
+    }
+
+    if (_shelf_x + bitmap.width + 1 > _width || _shelf_y + bitmap.height + 1 > _height) {
+        std::cerr << "Sprite atlas is full, " << bitmap.width << "x" << bitmap.height << " does not fit." << std::endl;
+        terminate();
+    }
+
+    // texture rows go bottom to top, bitmap rows top to bottom
+    std::vector<GLubyte> texels(bitmap.width * bitmap.height * 4);
+    for (GLsizei y = 0; y < bitmap.height; ++y) {
+        for (GLsizei x = 0; x < bitmap.width; ++x) {
+            GLubyte value = bitmap.at(x, y);
+            GLubyte* texel = &texels[((bitmap.height - 1 - y) * bitmap.width + x) * 4];
+
+            if (value == bitmap::empty) continue;
+
+            texel[0] = palette[value][0] * 255.0f + 0.5f;
+            texel[1] = palette[value][1] * 255.0f + 0.5f;
+            texel[2] = palette[value][2] * 255.0f + 0.5f;
+            texel[3] = 255;
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, _shelf_x, _shelf_y, bitmap.width, bitmap.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                    texels.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    region r{
+        (GLfloat) _shelf_x / _width,
+        (GLfloat) _shelf_y / _height,
+        (GLfloat) (_shelf_x + bitmap.width) / _width,
+        (GLfloat) (_shelf_y + bitmap.height) / _height,
+        bitmap.width,
+        bitmap.height
+    };
+
+    _shelf_x += bitmap.width + 1;
+    _shelf_height = std::max(_shelf_height, bitmap.height + 1);
+
+    return r;
+}
+
+void atlas::bind(GLuint unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, _texture);
+}
+
+sprite_batch::sprite_batch(GLsizei capacity) : _capacity(std::max(capacity, 1)) {
+    _program = create_shader_program({
+        compile_shader(&shader::sprite_vertex, GL_VERTEX_SHADER),
+        compile_shader(&shader::sprite_fragment, GL_FRAGMENT_SHADER)
+    });
+
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_vbo);
+
+    state().bind_vertex_array(_vao);
+    state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(quad), NULL, GL_DYNAMIC_DRAW);
+    vertex_layout<attributes::vec4, attributes::vec4>::enable(0, 1);
+
+    state().bind_vertex_array(0);
+    state().bind_buffer(GL_ARRAY_BUFFER, 0);
+}
+
+sprite_batch::~sprite_batch() {
+    state().delete_vertex_arrays(1, &_vao);
+    state().delete_buffers(1, &_vbo);
+    state().delete_program(_program);
+}
+
+void sprite_batch::add(const atlas::region& region, GLfloat pixel_size, GLfloat left, GLfloat top) {
+    GLfloat width = region.width * pixel_size;
+    GLfloat height = region.height * pixel_size;
+
+    _quads.push_back({{left, top - height, width, height}, {region.u0, region.v0, region.u1, region.v1}});
+    _dirty = true;
+}
+
+void sprite_batch::clear() {
+    _quads.clear();
+    _dirty = true;
+}
+
+void sprite_batch::draw(const atlas& atlas) {
+    if (_dirty) {
+        state().bind_buffer(GL_ARRAY_BUFFER, _vbo);
+        if ((GLsizei) _quads.size() > _capacity) {
+            while (_capacity < (GLsizei) _quads.size()) {
+                _capacity *= 2;
+            }
+            glBufferData(GL_ARRAY_BUFFER, _capacity * sizeof(quad), NULL, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, _quads.size() * sizeof(quad), _quads.data());
+        state().bind_buffer(GL_ARRAY_BUFFER, 0);
+
+        _dirty = false;
+    }
+
+    state().use_program(_program);
+    atlas.bind(0);
+    state().bind_vertex_array(_vao);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, _quads.size());
+}
+
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <glhelper/state.hpp>
+
+namespace glh {
+
+static constexpr GLenum TARGETS[] = {
+    GL_ARRAY_BUFFER,
+    GL_ELEMENT_ARRAY_BUFFER,
+    GL_COPY_READ_BUFFER,
+    GL_COPY_WRITE_BUFFER,
+    GL_UNIFORM_BUFFER,
+    GL_DRAW_INDIRECT_BUFFER,
+    GL_TEXTURE_BUFFER
+};
+
+static_assert(std::size(TARGETS) == state_cache::TRACKED_TARGETS);
+
+static std::size_t target_index(GLenum target) {
+    return std::find(std::begin(TARGETS), std::end(TARGETS), target) - std::begin(TARGETS);
+}
+
+state_cache::state_cache() {
+    invalidate();
+}
+
+bool state_cache::skip(bool unchanged) {
+    if (unchanged) {
+        ++_skipped;
+    } else {
+        ++_issued;
+    }
+    return unchanged;
+}
+
+void state_cache::use_program(GLuint program) {
+    if (skip(_program == program)) return;
+
+    glUseProgram(program);
+    _program = program;
+}
+
+void state_cache::bind_vertex_array(GLuint vao) {
+    if (skip(_vao == vao)) return;
+
+    glBindVertexArray(vao);
+    _vao = vao;
+    _buffers[target_index(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+}
+
+void state_cache::bind_buffer(GLenum target, GLuint buffer) {
+    std::size_t index = target_index(target);
+    if (skip(index < TRACKED_TARGETS && _buffers[index] == buffer)) return;
+
+    glBindBuffer(target, buffer);
+    if (index < TRACKED_TARGETS) {
+        _buffers[index] = buffer;
+    }
+}
+
+void state_cache::bind_buffer_base(GLenum target, GLuint index, GLuint buffer) {
+    bool tracked = target == GL_UNIFORM_BUFFER && index < UNIFORM_BINDINGS;
+    indexed_binding binding{buffer, 0, -1};
+    if (skip(tracked && _uniform_bindings[index] == binding)) return;
+
+    glBindBufferBase(target, index, buffer);
+    if (tracked) {
+        _uniform_bindings[index] = binding;
+    }
+    if (std::size_t i = target_index(target); i < TRACKED_TARGETS) {
+        _buffers[i] = buffer;
+    }
+}
+
+void state_cache::bind_buffer_range(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+    bool tracked = target == GL_UNIFORM_BUFFER && index < UNIFORM_BINDINGS;
+    indexed_binding binding{buffer, offset, size};
+    if (skip(tracked && _uniform_bindings[index] == binding)) return;
+
+    glBindBufferRange(target, index, buffer, offset, size);
+    if (tracked) {
+        _uniform_bindings[index] = binding;
+    }
+    if (std::size_t i = target_index(target); i < TRACKED_TARGETS) {
+        _buffers[i] = buffer;
+    }
+}
+
+void state_cache::polygon_mode(GLenum mode) {
+    if (skip(_polygon_mode == mode)) return;
+
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+    _polygon_mode = mode;
+}
+
+void state_cache::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+    std::array<GLint, 4> viewport{x, y, width, height};
+    if (skip(_viewport_known && _viewport == viewport)) return;
+
+    glViewport(x, y, width, height);
+    _viewport = viewport;
+    _viewport_known = true;
+}
+
+bool state_cache::cached(GLint location, const GLfloat* data, GLsizei size) {
+    // -1 is ignored by GL anyway
+    if (location < 0) return skip(true);
+    if (_program == UNKNOWN) return skip(false);
+
+    std::vector<uniform_value>& values = _uniforms[_program];
+    if ((std::size_t) location >= values.size()) {
+        values.resize(location + 1);
+    }
+
+    uniform_value& value = values[location];
+    bool unchanged = value.size == size && std::memcmp(value.data.data(), data, size * sizeof(GLfloat)) == 0;
+    if (!unchanged) {
+        std::memcpy(value.data.data(), data, size * sizeof(GLfloat));
+        value.size = size;
+    }
+    return skip(unchanged);
+}
+
+void state_cache::uniform(GLint location, GLint value) {
+    // integers are compared by their bits
+    GLfloat bits;
+    std::memcpy(&bits, &value, sizeof(value));
+    if (cached(location, &bits, 1)) return;
+    glUniform1i(location, value);
+}
+
+void state_cache::uniform(GLint location, GLfloat value) {
+    if (cached(location, &value, 1)) return;
+    glUniform1f(location, value);
+}
+
+void state_cache::uniform(GLint location, const glm::vec2& value) {
+    if (cached(location, glm::value_ptr(value), 2)) return;
+    glUniform2fv(location, 1, glm::value_ptr(value));
+}
+
+void state_cache::uniform(GLint location, const glm::vec3& value) {
+    if (cached(location, glm::value_ptr(value), 3)) return;
+    glUniform3fv(location, 1, glm::value_ptr(value));
+}
+
+void state_cache::uniform(GLint location, const glm::vec4& value) {
+    if (cached(location, glm::value_ptr(value), 4)) return;
+    glUniform4fv(location, 1, glm::value_ptr(value));
+}
+
+void state_cache::uniform(GLint location, const glm::mat3& value) {
+    if (cached(location, glm::value_ptr(value), 9)) return;
+    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void state_cache::uniform(GLint location, const glm::mat4& value) {
+    if (cached(location, glm::value_ptr(value), 16)) return;
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void state_cache::delete_vertex_arrays(GLsizei count, const GLuint* vaos) {
+    glDeleteVertexArrays(count, vaos);
+
+    // deleting the bound VAO binds 0
+    if (std::find(vaos, vaos + count, _vao) != vaos + count) {
+        _vao = 0;
+        _buffers[target_index(GL_ELEMENT_ARRAY_BUFFER)] = UNKNOWN;
+    }
+}
+
+void state_cache::delete_buffers(GLsizei count, const GLuint* buffers) {
+    glDeleteBuffers(count, buffers);
+
+    // deleted buffers are unbound from every target
+    for (GLuint& bound : _buffers) {
+        if (std::find(buffers, buffers + count, bound) != buffers + count) {
+            bound = 0;
+        }
+    }
+    for (indexed_binding& binding : _uniform_bindings) {
+        if (std::find(buffers, buffers + count, binding.buffer) != buffers + count) {
+            binding = {0, 0, -1};
+        }
+    }
+}
+
+void state_cache::delete_program(GLuint program) {
+    glDeleteProgram(program);
+
+    // a program in use is only deleted once it isn't, so the name can't come back before then
+    _uniforms.erase(program);
+}
+
+void state_cache::invalidate() {
+    _program = UNKNOWN;
+    _vao = UNKNOWN;
+    _buffers.fill(UNKNOWN);
+    _uniform_bindings.fill({UNKNOWN, 0, -1});
+    _polygon_mode = GL_NONE;
+    _viewport_known = false;
+    _uniforms.clear();
+}
+
+void state_cache::reset_counters() {
+    _issued = 0;
+    _skipped = 0;
+}
+
+state_cache& state() {
+    static state_cache cache;
+    return cache;
+}
+
+}
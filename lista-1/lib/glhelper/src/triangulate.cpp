@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <set>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include <glhelper/glhelper.hpp>
+
+namespace glh {
+
+namespace shapes {
+
+namespace {
+
+// monotone decomposition as in de Berg et al., Computational Geometry, chapter 3
+//
+// every ring is oriented so the interior lies to the left of its edges, the outline
+// counterclockwise and the holes clockwise. edge i goes from vertex i to next[i].
+struct polygon {
+    std::span<const GLfloat> xy;
+    std::vector<GLuint> next;
+    std::vector<GLuint> prev;
+
+    GLfloat x(GLuint v) const { return xy[2 * v]; }
+    GLfloat y(GLuint v) const { return xy[2 * v + 1]; }
+
+    // sweep order, top to bottom and left to right on ties
+    bool above(GLuint a, GLuint b) const {
+        return y(a) > y(b) || (y(a) == y(b) && x(a) < x(b));
+    }
+
+    // > 0 when c is to the left of a -> b
+    double cross(GLuint a, GLuint b, GLuint c) const {
+        return ((double) x(b) - x(a)) * ((double) y(c) - y(a)) - ((double) y(b) - y(a)) * ((double) x(c) - x(a));
+    }
+};
+
+enum class vertex_kind { start, end, split, merge, regular };
+
+// edges in the sweep status go downward, from upper to lower
+struct edge {
+    GLuint upper;
+    GLuint lower;
+};
+
+void add_ring(polygon& polygon, GLuint first, GLuint count, bool counterclockwise) {
+    double area = 0;
+    for (GLuint i = 0; i < count; ++i) {
+        GLuint a = first + i;
+        GLuint b = first + (i + 1) % count;
+        area += (double) polygon.x(a) * polygon.y(b) - (double) polygon.x(b) * polygon.y(a);
+    }
+
+    bool reverse = (area > 0) != counterclockwise;
+    for (GLuint i = 0; i < count; ++i) {
+        GLuint v = first + i;
+        GLuint after = first + (i + 1) % count;
+        GLuint before = first + (i + count - 1) % count;
+
+        polygon.next[v] = reverse ? before : after;
+        polygon.prev[v] = reverse ? after : before;
+    }
+}
+
+vertex_kind classify(const polygon& polygon, GLuint v) {
+    GLuint prev = polygon.prev[v];
+    GLuint next = polygon.next[v];
+    bool convex = polygon.cross(prev, v, next) > 0;
+
+    if (polygon.above(v, prev) && polygon.above(v, next)) {
+        return convex ? vertex_kind::start : vertex_kind::split;
+    }
+    if (polygon.above(prev, v) && polygon.above(next, v)) {
+        return convex ? vertex_kind::end : vertex_kind::merge;
+    }
+    return vertex_kind::regular;
+}
+
+// diagonals splitting the polygon into y-monotone pieces
+std::vector<std::pair<GLuint, GLuint>> monotone_diagonals(const polygon& polygon) {
+    GLuint count = polygon.next.size();
+
+    std::vector<GLuint> events(count);
+    std::iota(events.begin(), events.end(), 0);
+    std::sort(events.begin(), events.end(), [&polygon](GLuint a, GLuint b) {
+        return polygon.above(a, b);
+    });
+
+    // the extra slot is the probe, it stands for "no edge" in malformed input
+    std::vector<vertex_kind> kinds(count + 1, vertex_kind::regular);
+    for (GLuint v = 0; v < count; ++v) {
+        kinds[v] = classify(polygon, v);
+    }
+
+    // edge i is identified by its first vertex, a probe edge with upper == lower is a point query
+    std::vector<edge> edges(count);
+    for (GLuint v = 0; v < count; ++v) {
+        edges[v] = {v, polygon.next[v]};
+    }
+    edges.push_back({0, 0});
+    const GLuint PROBE = count;
+
+    // left to right at the sweep line, edges never cross so the order stays valid as it moves
+    auto left_of = [&polygon, &edges](GLuint a, GLuint b) {
+        if (a == b) return false;
+
+        const edge& ea = edges[a];
+        const edge& eb = edges[b];
+
+        // test the edge that started lower against the other one
+        if (!polygon.above(ea.upper, eb.upper)) {
+            double side = polygon.cross(eb.upper, eb.lower, ea.upper);
+            if (side == 0) side = polygon.cross(eb.upper, eb.lower, ea.lower);
+            // to the left when looking down the edge is east
+            return side < 0;
+        } else {
+            double side = polygon.cross(ea.upper, ea.lower, eb.upper);
+            if (side == 0) side = polygon.cross(ea.upper, ea.lower, eb.lower);
+            return side > 0;
+        }
+    };
+
+    std::set<GLuint, decltype(left_of)> status(left_of);
+    std::vector<GLuint> helper(count + 1, count);
+    std::vector<std::pair<GLuint, GLuint>> diagonals;
+
+    auto edge_left_of = [&](GLuint v) {
+        edges[PROBE] = {v, v};
+        auto it = status.lower_bound(PROBE);
+        return it == status.begin() ? PROBE : *std::prev(it);
+    };
+    auto fix_up = [&](GLuint v, GLuint e) {
+        if (e != PROBE && kinds[helper[e]] == vertex_kind::merge) {
+            diagonals.emplace_back(v, helper[e]);
+        }
+    };
+
+    for (GLuint v : events) {
+        GLuint previous = polygon.prev[v];
+
+        switch (kinds[v]) {
+            case vertex_kind::start:
+                status.insert(v);
+                helper[v] = v;
+                break;
+
+            case vertex_kind::end:
+                fix_up(v, previous);
+                status.erase(previous);
+                break;
+
+            case vertex_kind::split: {
+                GLuint left = edge_left_of(v);
+                if (left != PROBE) {
+                    diagonals.emplace_back(v, helper[left]);
+                    helper[left] = v;
+                }
+                status.insert(v);
+                helper[v] = v;
+                break;
+            }
+
+            case vertex_kind::merge: {
+                fix_up(v, previous);
+                status.erase(previous);
+                GLuint left = edge_left_of(v);
+                fix_up(v, left);
+                if (left != PROBE) helper[left] = v;
+                break;
+            }
+
+            case vertex_kind::regular:
+                if (polygon.above(previous, v)) {
+                    // on a left chain, the interior is to the east
+                    fix_up(v, previous);
+                    status.erase(previous);
+                    status.insert(v);
+                    helper[v] = v;
+                } else {
+                    GLuint left = edge_left_of(v);
+                    fix_up(v, left);
+                    if (left != PROBE) helper[left] = v;
+                }
+                break;
+        }
+    }
+
+    return diagonals;
+}
+
+// walks the faces of the polygon cut by the diagonals, each returned counterclockwise
+std::vector<std::vector<GLuint>> faces(const polygon& polygon, const std::vector<std::pair<GLuint, GLuint>>& diagonals) {
+    GLuint count = polygon.next.size();
+
+    // outgoing half-edges of each vertex, sorted by angle
+    std::vector<std::vector<std::pair<double, GLuint>>> outgoing(count);
+    auto angle = [&polygon](GLuint from, GLuint to) {
+        return std::atan2((double) polygon.y(to) - polygon.y(from), (double) polygon.x(to) - polygon.x(from));
+    };
+
+    for (GLuint v = 0; v < count; ++v) {
+        outgoing[v].emplace_back(angle(v, polygon.next[v]), polygon.next[v]);
+    }
+    for (auto [a, b] : diagonals) {
+        outgoing[a].emplace_back(angle(a, b), b);
+        outgoing[b].emplace_back(angle(b, a), a);
+    }
+
+    for (auto& edges : outgoing) {
+        std::sort(edges.begin(), edges.end());
+    }
+
+    // the face continues with the first outgoing edge clockwise from the way back
+    auto next = [&](GLuint from, GLuint to) {
+        const auto& edges = outgoing[to];
+        double back = angle(to, from);
+
+        auto it = std::lower_bound(edges.begin(), edges.end(), std::pair<double, GLuint>(back, 0));
+        return it == edges.begin() ? edges.back().second : std::prev(it)->second;
+    };
+
+    std::vector<std::vector<bool>> visited(count);
+    for (GLuint v = 0; v < count; ++v) {
+        visited[v].resize(outgoing[v].size(), false);
+    }
+    auto visit = [&](GLuint from, GLuint to) {
+        const auto& edges = outgoing[from];
+        for (std::size_t i = 0; i < edges.size(); ++i) {
+            if (edges[i].second == to && !visited[from][i]) {
+                visited[from][i] = true;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<std::vector<GLuint>> result;
+    for (GLuint v = 0; v < count; ++v) {
+        for (std::size_t i = 0; i < outgoing[v].size(); ++i) {
+            if (visited[v][i]) continue;
+
+            std::vector<GLuint> face;
+            GLuint from = v;
+            GLuint to = outgoing[v][i].second;
+            visited[v][i] = true;
+
+            while (true) {
+                face.push_back(from);
+                GLuint after = next(from, to);
+                from = to;
+                to = after;
+                if (!visit(from, to)) break;
+            }
+
+            result.push_back(std::move(face));
+        }
+    }
+
+    return result;
+}
+
+// stack-based triangulation of a y-monotone face
+void triangulate_monotone(const polygon& polygon, const std::vector<GLuint>& face, std::vector<GLuint>& indices) {
+    std::size_t count = face.size();
+    if (count < 3) return;
+
+    auto emit = [&](GLuint a, GLuint b, GLuint c) {
+        double area = polygon.cross(a, b, c);
+        if (area == 0) return;
+        if (area < 0) std::swap(b, c);
+        indices.insert(indices.end(), {a, b, c});
+    };
+
+    if (count == 3) {
+        emit(face[0], face[1], face[2]);
+        return;
+    }
+
+    std::size_t top = 0;
+    std::size_t bottom = 0;
+    for (std::size_t i = 1; i < count; ++i) {
+        if (polygon.above(face[i], face[top])) top = i;
+        if (polygon.above(face[bottom], face[i])) bottom = i;
+    }
+
+    // counterclockwise from the top runs down the left chain, flags are indexed by position in the face
+    std::vector<bool> left(count, false);
+    for (std::size_t i = top; i != bottom; i = (i + 1) % count) {
+        left[i] = true;
+    }
+
+    // a monotone face could be merged chain by chain, sorting keeps this short and still O(k log k)
+    // for a face of k vertices, so O(n log n) over all faces
+    std::vector<std::size_t> sorted(count);
+    for (std::size_t i = 0; i < count; ++i) sorted[i] = i;
+    std::sort(sorted.begin(), sorted.end(), [&polygon, &face](std::size_t a, std::size_t b) {
+        return polygon.above(face[a], face[b]);
+    });
+
+    std::vector<std::size_t> stack{sorted[0], sorted[1]};
+    for (std::size_t j = 2; j + 1 < count; ++j) {
+        std::size_t v = sorted[j];
+
+        if (left[v] != left[stack.back()]) {
+            // opposite chain, every stacked vertex can see v
+            for (std::size_t k = 0; k + 1 < stack.size(); ++k) {
+                emit(face[v], face[stack[k]], face[stack[k + 1]]);
+            }
+            stack = {sorted[j - 1], v};
+        } else {
+            std::size_t last = stack.back();
+            stack.pop_back();
+
+            // pop while the diagonal from v stays inside
+            while (!stack.empty()) {
+                double side = polygon.cross(face[stack.back()], face[v], face[last]);
+                if (left[v] ? side >= 0 : side <= 0) break;
+
+                emit(face[v], face[last], face[stack.back()]);
+                last = stack.back();
+                stack.pop_back();
+            }
+
+            stack.push_back(last);
+            stack.push_back(v);
+        }
+    }
+
+    std::size_t v = sorted[count - 1];
+    for (std::size_t k = 0; k + 1 < stack.size(); ++k) {
+        emit(face[v], face[stack[k]], face[stack[k + 1]]);
+    }
+}
+
+}
+
+shape triangulate(std::span<const GLfloat> outline, std::span<const std::vector<GLfloat>> holes) {
+    shape result;
+
+    std::size_t size = outline.size();
+    for (const auto& hole : holes) {
+        size += hole.size();
+    }
+
+    result.vertices.reserve(size);
+    result.vertices.insert(result.vertices.end(), outline.begin(), outline.end());
+    for (const auto& hole : holes) {
+        result.vertices.insert(result.vertices.end(), hole.begin(), hole.end());
+    }
+
+    GLuint count = size / 2;
+    if (outline.size() < 6) return result;
+
+    polygon polygon{result.vertices, std::vector<GLuint>(count), std::vector<GLuint>(count)};
+
+    add_ring(polygon, 0, outline.size() / 2, true);
+    GLuint first = outline.size() / 2;
+    for (const auto& hole : holes) {
+        add_ring(polygon, first, hole.size() / 2, false);
+        first += hole.size() / 2;
+    }
+
+    result.indices.reserve(3 * (count + 2 * holes.size()));
+    for (const auto& face : faces(polygon, monotone_diagonals(polygon))) {
+        triangulate_monotone(polygon, face, result.indices);
+    }
+
+    return result;
+}
+
+}
+
+}
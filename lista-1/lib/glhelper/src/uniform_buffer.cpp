@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <glhelper/glhelper.hpp>
+#include <glhelper/uniform_buffer.hpp>
+
+namespace glh {
+
+void bind_uniform_block(GLuint program, const GLchar* name, GLuint binding) {
+    GLuint index = glGetUniformBlockIndex(program, name);
+    if (index != GL_INVALID_INDEX) {
+        glUniformBlockBinding(program, index, binding);
+    }
+}
+
+frame_uniforms::frame_uniforms() : _buffer(make_buffer()) {
+    layout::write(_data.data(), glm::mat4(1.0f), glm::mat4(1.0f), 0.0f);
+
+    state().bind_buffer(GL_UNIFORM_BUFFER, _buffer);
+    glBufferData(GL_UNIFORM_BUFFER, layout::size, NULL, GL_DYNAMIC_DRAW);
+    state().bind_buffer_base(GL_UNIFORM_BUFFER, FRAME_BINDING, _buffer);
+}
+
+void frame_uniforms::set_projection(const glm::mat4& projection) {
+    std140::write(_data.data() + layout::offsets[0], projection);
+    _dirty = true;
+}
+
+void frame_uniforms::set_view(const glm::mat4& view) {
+    std140::write(_data.data() + layout::offsets[1], view);
+    _dirty = true;
+}
+
+void frame_uniforms::set_time(GLfloat time) {
+    std140::write(_data.data() + layout::offsets[2], time);
+    _dirty = true;
+}
+
+void frame_uniforms::update() {
+    if (!_dirty) return;
+
+    state().bind_buffer(GL_UNIFORM_BUFFER, _buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, layout::size, _data.data());
+    _dirty = false;
+}
+
+material_ring::material_ring(GLsizeiptr material_size, GLsizei capacity, GLsizei regions)
+    : _material_size(material_size), _capacity(std::max(capacity, 1)), _regions(std::max(regions, 1)),
+      _fences(_regions, nullptr) {
+    GLint alignment;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment = std::max(alignment, 1);
+    _stride = (material_size + alignment - 1) / alignment * alignment;
+
+    allocate();
+}
+
+material_ring::~material_ring() {
+    for (GLsync fence : _fences) {
+        if (fence) glDeleteSync(fence);
+    }
+}
+
+void material_ring::allocate() {
+    if (!_buffer) {
+        _buffer = make_buffer();
+    }
+
+    state().bind_buffer(GL_UNIFORM_BUFFER, _buffer);
+    glBufferData(GL_UNIFORM_BUFFER, _stride * _capacity * _regions, NULL, GL_STREAM_DRAW);
+}
+
+void material_ring::begin_frame() {
+    // the draws of the frame that just ended are the last to read the current region
+    if (_fences[_region]) glDeleteSync(_fences[_region]);
+    _fences[_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    _region = (_region + 1) % _regions;
+    if (GLsync fence = _fences[_region]) {
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        glDeleteSync(fence);
+        _fences[_region] = nullptr;
+    }
+
+    _staging.clear();
+    _uploaded = 0;
+}
+
+GLuint material_ring::add(const GLvoid* material) {
+    GLuint index = size();
+
+    if ((GLsizei) index == _capacity) {
+        // the new storage is orphaned from any pending draw, only this frame's materials go back in
+        _capacity *= 2;
+        allocate();
+        _uploaded = 0;
+    }
+
+    _staging.resize(_staging.size() + _stride);
+    std::memcpy(_staging.data() + index * _stride, material, _material_size);
+    return index;
+}
+
+void material_ring::upload() {
+    GLsizeiptr pending = _staging.size() - _uploaded;
+    if (pending == 0) return;
+
+    // the region isn't read by any pending draw, so the driver needn't synchronize
+    GLintptr offset = _region * _capacity * _stride + _uploaded;
+    state().bind_buffer(GL_UNIFORM_BUFFER, _buffer);
+    void* data = glMapBufferRange(GL_UNIFORM_BUFFER, offset, pending,
+                                  GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (data == NULL) {
+        std::cerr << "Failed to map the material buffer." << std::endl;
+        terminate();
+    }
+    std::memcpy(data, _staging.data() + _uploaded, pending);
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
+
+    _uploaded = _staging.size();
+}
+
+void material_ring::bind(GLuint index) {
+    upload();
+
+    GLintptr offset = _region * _capacity * _stride + index * _stride;
+    state().bind_buffer_range(GL_UNIFORM_BUFFER, MATERIAL_BINDING, _buffer, offset, _material_size);
+}
+
+}
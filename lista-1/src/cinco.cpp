@@ -29,59 +29,52 @@ int main() {
     glfwSetFramebufferSizeCallback(window, glh::glfw_frambuffer_size_callback_square);
     glfwSetKeyCallback(window, glfw_key_callback);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&glh::shader::basic_vertex, GL_VERTEX_SHADER),
-        glh::compile_shader(&glh::shader::basic_fragment, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
-
-    // geometry
-    glh::shape triangles_middle;
+    // GL objects are released at the end of this scope, while the context still exists
     {
-        glh::shape triangle1 = glh::shapes::make_triangle(0.3f, -0.5f);
-        glh::shape triangle2 = glh::shapes::make_triangle(0.3f, 0.5f);
-        glh::shapes::rotate(triangle2, 180.0f, 0.5f, 0.0f);
-        triangles_middle = glh::shapes::group({triangle1, triangle2});
-    }
-    glh::shape triangles_top = triangles_middle;
-    glh::shapes::translate(triangles_top, 0.0f, 0.6f);
-    glh::shape triangles_bottom = triangles_middle;
-    glh::shapes::translate(triangles_bottom, 0.0f, -0.6f);
-
-    GLuint top    = glh::create_vao(triangles_top);
-    GLuint middle = glh::create_vao(triangles_middle);
-    GLuint bottom = glh::create_vao(triangles_bottom);
-
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
-    glPointSize(8);
-    glLineWidth(2);
-
-    // main loop
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-        glBindVertexArray(top);
-        glDrawElements(GL_POINTS, triangles_top.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-
-        glBindVertexArray(middle);
-        glDrawElements(GL_TRIANGLES, triangles_middle.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-        glBindVertexArray(bottom);
-        glDrawElements(GL_TRIANGLES, triangles_bottom.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
+        // shader program
+        glh::program_handle shader_program(glh::create_shader_program({
+            glh::compile_shader(&glh::shader::basic_vertex, GL_VERTEX_SHADER),
+            glh::compile_shader(&glh::shader::basic_fragment, GL_FRAGMENT_SHADER)
+        }));
+        glh::state().use_program(shader_program);
+
+        // geometry
+        glh::shape triangles_middle;
+        {
+            glh::shape triangle1 = glh::shapes::make_triangle(0.3f, -0.5f);
+            glh::shape triangle2 = glh::shapes::make_triangle(0.3f, 0.5f);
+            glh::shapes::rotate(triangle2, 180.0f, 0.5f, 0.0f);
+            triangles_middle = glh::shapes::group({triangle1, triangle2});
+        }
+        glh::shape triangles_top = triangles_middle;
+        glh::shapes::translate(triangles_top, 0.0f, 0.6f);
+        glh::shape triangles_bottom = triangles_middle;
+        glh::shapes::translate(triangles_bottom, 0.0f, -0.6f);
+
+        glh::mesh top    = glh::create_mesh(triangles_top);
+        glh::mesh middle = glh::create_mesh(triangles_middle);
+        glh::mesh bottom = glh::create_mesh(triangles_bottom);
+
+        glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
+        glPointSize(8);
+        glLineWidth(2);
+
+        // main loop
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glh::state().polygon_mode(GL_FILL);
+            glh::draw(top, GL_POINTS);
+            glh::draw(middle);
+
+            glh::state().polygon_mode(GL_LINE);
+            glh::draw(bottom);
         
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
-    // clean up
-    glDeleteVertexArrays(1, &top);
-    glDeleteVertexArrays(1, &middle);
-    glDeleteVertexArrays(1, &bottom);
-    glDeleteProgram(shader_program);
-
     glfwTerminate();
 
     return 0;
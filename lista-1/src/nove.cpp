@@ -1,19 +1,35 @@
+#include <array>
 #include <iostream>
-#include <vector>
+#include <string_view>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
 #include <glhelper/glhelper.hpp>
+#include <glhelper/optimize.hpp>
+#include <glhelper/sprite.hpp>
 
 void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
-constexpr glh::shape make_hat();
-constexpr glh::shape make_head();
-constexpr glh::shape make_face();
-
 constexpr GLfloat PIXEL = 0.08f;
 
+// R: hat, S: skin, B: hair, eye and mustache
+constexpr std::array<std::string_view, 7> SPRITE{
+    "..RRRRR....",
+    ".RRRRRRRRR.",
+    ".BBBSSBS...",
+    "BSBSSSBSSS.",
+    "BSBBSSSBSSS",
+    "BBSSSSBBBB.",
+    "..SSSSSSS.."
+};
+
+constexpr std::array<glh::sprites::color, 3> PALETTE{{
+    {0.94f, 0.23f, 0.22f},
+    {1.0f, 0.8f, 0.4f},
+    {0.6f, 0.41f, 0.16f}
+}};
+
 bool wireframe = false;
 
 int main() {
@@ -37,116 +53,43 @@ int main() {
     glfwSetFramebufferSizeCallback(window, glh::glfw_frambuffer_size_callback_square);
     glfwSetKeyCallback(window, glfw_key_callback);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&glh::shader::basic_vertex, GL_VERTEX_SHADER),
-        glh::compile_shader(&glh::shader::basic_fragment_uniform, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
-
-    // geometry
-    glh::shape hat = make_hat();
-    GLuint hat_vao = glh::create_vao(hat);
-
-    glh::shape head = make_head();
-    GLuint head_vao = glh::create_vao(head);
+    // GL objects are released at the end of this scope, while the context still exists
+    {
+        // shader program
+        glh::program_handle shader_program(glh::create_shader_program({
+            glh::compile_shader(&glh::shader::basic_vertex_color, GL_VERTEX_SHADER),
+            glh::compile_shader(&glh::shader::basic_fragment_color, GL_FRAGMENT_SHADER)
+        }));
+        glh::state().use_program(shader_program);
 
-    glh::shape face = make_face();
-    GLuint face_vao = glh::create_vao(face);
+        // geometry, the whole sprite is one mesh with per-vertex colors
+        glh::sprites::bitmap bitmap = glh::sprites::make_bitmap(SPRITE, "RSB");
+        glh::color_shape sprite = glh::sprites::greedy_mesh(bitmap, PALETTE, PIXEL, -5 * PIXEL, 4 * PIXEL);
 
-    GLuint uniform_location = glGetUniformLocation(shader_program, "uniform_color");
+        // rectangles of the same color share corners, weld them and reorder for the vertex cache
+        glh::optimize::run(sprite);
 
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
-    glLineWidth(2);
+        glh::mesh mesh = glh::create_mesh(sprite);
 
-    // main loop
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
+        glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
+        glLineWidth(2);
 
-        glUniform3f(uniform_location, 0.94f, 0.23f, 0.22f);
-        glBindVertexArray(hat_vao);
-        glDrawElements(GL_TRIANGLES, hat.indices.size(), GL_UNSIGNED_INT, 0);
+        // main loop
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
 
-        glUniform3f(uniform_location, 1.0f, 0.8f, 0.4f);
-        glBindVertexArray(head_vao);
-        glDrawElements(GL_TRIANGLES, head.indices.size(), GL_UNSIGNED_INT, 0);
+            glh::draw(mesh);
 
-        glUniform3f(uniform_location, 0.6f, 0.41f, 0.16f);
-        glBindVertexArray(face_vao);
-        glDrawElements(GL_TRIANGLES, face.indices.size(), GL_UNSIGNED_INT, 0);
-        
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
-    // clean up
-    glDeleteVertexArrays(1, &hat_vao);
-    glDeleteVertexArrays(1, &head_vao);
-    glDeleteVertexArrays(1, &face_vao);
-    glDeleteProgram(shader_program);
-
     glfwTerminate();
 
     return 0;
 }
 
-constexpr glh::shape make_head() {
-    glh::shape one = glh::shapes::make_rectangle(4 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(one, -1 * PIXEL, 1 * PIXEL);
-
-    glh::shape two = glh::shapes::make_rectangle(9 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(two, -4 * PIXEL, 0.0f);
-
-    glh::shape three = glh::shapes::make_rectangle(10 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(three, -4 * PIXEL, -1 * PIXEL);
-
-    glh::shape four = glh::shapes::make_rectangle(4 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(four, -3 * PIXEL, -2 * PIXEL);
-
-    glh::shape five = glh::shapes::make_rectangle(7 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(five, -3 * PIXEL, -3 * PIXEL);
-
-    return glh::shapes::group({one, two, three, four, five});
-}
-
-constexpr glh::shape make_hat() {
-    glh::shape top = glh::shapes::make_rectangle(5 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(top, -3 * PIXEL, 3 * PIXEL);
-
-    glh::shape bottom = glh::shapes::make_rectangle(9 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(bottom, -4 * PIXEL, 2 * PIXEL);
-
-    return glh::shapes::group({top, bottom});
-}
-
-constexpr glh::shape make_face() {
-    glh::shape eye = glh::shapes::make_rectangle(1 * PIXEL, 2 * PIXEL);
-    glh::shapes::translate(eye, 1 * PIXEL, 0.0f);
-
-    glh::shape mustache1 = glh::shapes::make_rectangle(1 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(mustache1, 2 * PIXEL, -1 * PIXEL);
-
-    glh::shape mustache2 = glh::shapes::make_rectangle(4 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(mustache2, 1 * PIXEL, -2 * PIXEL);
-
-    glh::shape hair1 = glh::shapes::make_rectangle(3 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(hair1, -4 * PIXEL, 1 * PIXEL);
-
-    glh::shape hair2 = glh::shapes::make_rectangle(1 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(hair2, -3 * PIXEL, 0.0f);
-
-    glh::shape hair3 = glh::shapes::make_rectangle(2 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(hair3, -3 * PIXEL, -1 * PIXEL);
-
-    glh::shape hair4 = glh::shapes::make_rectangle(1 * PIXEL, 3 * PIXEL);
-    glh::shapes::translate(hair4, -5 * PIXEL, -2 * PIXEL);
-
-    glh::shape hair5 = glh::shapes::make_rectangle(1 * PIXEL, 1 * PIXEL);
-    glh::shapes::translate(hair5, -4 * PIXEL, -2 * PIXEL);
-
-    return glh::shapes::group({eye, mustache1, mustache2, hair1, hair2, hair3, hair4, hair5});
-}
-
 void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
         glfwSetWindowShouldClose(window, GLFW_TRUE);
@@ -154,6 +97,6 @@ void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, in
 
     if (key == GLFW_KEY_W && action == GLFW_PRESS) {
         wireframe = !wireframe;
-        glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
+        glh::state().polygon_mode(wireframe ? GL_LINE : GL_FILL);
     }
 }
\ No newline at end of file
@@ -3,8 +3,10 @@
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#include <glm/gtc/type_ptr.hpp>
 
 #include <glhelper/glhelper.hpp>
+#include <glhelper/compress.hpp>
 
 void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
@@ -29,55 +31,43 @@ int main() {
     glfwSetFramebufferSizeCallback(window, glh::glfw_frambuffer_size_callback_square);
     glfwSetKeyCallback(window, glfw_key_callback);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&glh::shader::basic_vertex_color, GL_VERTEX_SHADER),
-        glh::compile_shader(&glh::shader::basic_fragment_color, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
-
-    // geometry
-    std::vector<GLfloat> vertex_data{
-         0.0f,  0.6f, 0.99f, 0.03f, 0.0f,
-        -0.6f, -0.5f, 0.44f, 0.69f, 0.30f,
-         0.6f, -0.3f, 0.36f, 0.62f, 0.82f,
-    };
-
-    GLuint vao, vbo;
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-
-    glBufferData(GL_ARRAY_BUFFER, vertex_data.size() * sizeof(GLfloat), vertex_data.data(), GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*) 0);
-    glEnableVertexAttribArray(0);
-
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), (GLvoid*) (2 * sizeof(GLfloat)));
-    glEnableVertexAttribArray(1);
-
-    glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
-
-    glPointSize(16);
-
-    // main loop
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        glDrawArrays(GL_POINTS, 0, 3);
-
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    // GL objects are released at the end of this scope, while the context still exists
+    {
+        // shader program
+        glh::program_handle shader_program(glh::create_shader_program({
+            glh::compile_shader(&glh::shader::transform_vertex_color, GL_VERTEX_SHADER),
+            glh::compile_shader(&glh::shader::basic_fragment_color, GL_FRAGMENT_SHADER)
+        }));
+        glh::state().use_program(shader_program);
+
+        // geometry
+        glh::color_shape triangle{{
+             0.0f,  0.6f, 0.99f, 0.03f, 0.0f,
+            -0.6f, -0.5f, 0.44f, 0.69f, 0.30f,
+             0.6f, -0.3f, 0.36f, 0.62f, 0.82f,
+        }};
+
+        // 8 bytes per vertex instead of 20
+        glh::compressed_mesh mesh = glh::create_compressed_mesh(triangle);
+        glh::state().bind_vertex_array(mesh.vao);
+        glUniformMatrix3fv(glGetUniformLocation(shader_program, "transform"), 1, GL_FALSE, glm::value_ptr(mesh.decode));
+
+        glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+        glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
+
+        glPointSize(16);
+
+        // main loop
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glDrawArrays(GL_POINTS, 0, 3);
+
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
-    // clean up
-    glDeleteVertexArrays(1, &vao);
-    glDeleteBuffers(1, &vbo);
-    glDeleteProgram(shader_program);
-
     glfwTerminate();
 
     return 0;
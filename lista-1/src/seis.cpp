@@ -1,36 +1,30 @@
 #include <algorithm>
 #include <iostream>
-#include <utility>
 #include <vector>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
 #include <glhelper/glhelper.hpp>
+#include <glhelper/lod.hpp>
+#include <glhelper/static_shapes.hpp>
 
 void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
 GLuint shape_count, idx{0};
 bool wireframe = false;
-
-constexpr void remove_sides(glh::shape& shape, GLuint count) {
-    if (3 * count > shape.indices.size()) return;
-
-    GLuint keep = shape.indices.size() / 3 - count;
-
-    shape.vertices.erase(shape.vertices.begin() + 2 * keep, shape.vertices.begin() + 2 * (keep + count));
-    shape.indices.erase(shape.indices.begin() + 3 * keep, shape.indices.end());
-    std::for_each(shape.indices.begin(), shape.indices.end(), [keep](GLuint& i) {
-        i = std::min(i, keep);
-    });
-}
+GLfloat zoom = 1.0f;
 
 int main() {
     // GLFW init
     glfwSetErrorCallback(glh::glfw_error_callback);
     glfwInit();
 
-    GLFWwindow* window = glh::create_window("6 - Use arrow keys to cycle shapes");
+    GLFWwindow* window = glh::create_window("6 - Use arrow keys to cycle shapes and zoom");
     glfwMakeContextCurrent(window);
 
     // GLAD init
@@ -46,52 +40,61 @@ int main() {
     glfwSetFramebufferSizeCallback(window, glh::glfw_frambuffer_size_callback_square);
     glfwSetKeyCallback(window, glfw_key_callback);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&glh::shader::basic_vertex, GL_VERTEX_SHADER),
-        glh::compile_shader(&glh::shader::basic_fragment, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
-
-    // geometry
-    glh::shape circle   = glh::shapes::make_polygon(0.5f, 60);
-    glh::shape octagon  = glh::shapes::make_polygon(0.5f, 8);
-    glh::shape pentagon = glh::shapes::make_polygon(0.5f, 5);
-    glh::shape pacman   = glh::shapes::make_polygon(0.5f, 60);
-    remove_sides(pacman, 10);
-    glh::shape pizza    = glh::shapes::make_polygon(1.0f, 60, -0.5f, -0.25f);
-    remove_sides(pizza, 50);
-    glh::shape star     = glh::shapes::make_star(0.5f, 5);
-
-    std::vector<std::pair<GLuint, glh::shape&>> shapes{
-        {glh::create_vao(circle), circle},
-        {glh::create_vao(octagon), octagon},
-        {glh::create_vao(pentagon), pentagon},
-        {glh::create_vao(pacman), pacman},
-        {glh::create_vao(pizza), pizza},
-        {glh::create_vao(star), star}
-    };
-    shape_count = shapes.size();
-
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
-
-    // main loop
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        glBindVertexArray(shapes[idx].first);
-        glDrawElements(GL_TRIANGLES, shapes[idx].second.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-        
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    // GL objects are released at the end of this scope, while the context still exists
+    {
+        // shader program
+        glh::program_handle shader_program(glh::create_shader_program({
+            glh::compile_shader(&glh::shader::projection_vertex, GL_VERTEX_SHADER),
+            glh::compile_shader(&glh::shader::basic_fragment, GL_FRAGMENT_SHADER)
+        }));
+        glh::state().use_program(shader_program);
+        GLint projection_location = glGetUniformLocation(shader_program, "projection");
+
+        // geometry
+        static constexpr auto octagon  = glh::shapes::fixed::make_polygon<8>(0.5f);
+        static constexpr auto pentagon = glh::shapes::fixed::make_polygon<5>(0.5f);
+        glh::shape pacman   = glh::shapes::make_sector(0.5f, 0.0f, 300.0f, 50);
+        glh::shape pizza    = glh::shapes::make_sector(1.0f, 0.0f, 60.0f, 10, -0.5f, -0.25f);
+        static constexpr auto star     = glh::shapes::fixed::make_star<5>(0.5f);
+
+        // meshes own their VAO, so they are moved into the vector rather than copied from a list
+        std::vector<glh::mesh> shapes;
+        shapes.push_back(glh::create_mesh(octagon));
+        shapes.push_back(glh::create_mesh(pentagon));
+        shapes.push_back(glh::create_mesh(pacman));
+        shapes.push_back(glh::create_mesh(pizza));
+        shapes.push_back(glh::create_mesh(star));
+        shape_count = shapes.size() + 1;
+
+        glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
+
+        // the circle's segment count follows its size on screen
+        glh::circle_lod circle(0.5f);
+
+        // main loop
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glm::mat4 projection = glm::ortho(-1.0f / zoom, 1.0f / zoom, -1.0f / zoom, 1.0f / zoom);
+            // only reaches GL when the zoom changed
+            glh::state().uniform(projection_location, projection);
+
+            if (idx == 0) {
+                GLint viewport[4];
+                glGetIntegerv(GL_VIEWPORT, viewport);
+                circle.draw(projection, viewport[2], viewport[3]);
+            } else {
+                glh::draw(shapes[idx - 1]);
+            }
+
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
+
+        std::cout << "GL calls issued: " << glh::state().issued()
+                  << ", skipped: " << glh::state().skipped() << std::endl;
     }
 
-    // clean up
-    glDeleteProgram(shader_program);
-    std::for_each(shapes.begin(), shapes.end(), [](const auto& s) {
-        glDeleteVertexArrays(1, &s.first);
-    });
-
     glfwTerminate();
 
     return 0;
@@ -104,7 +107,7 @@ void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, in
 
     if (key == GLFW_KEY_W && action == GLFW_PRESS) {
         wireframe = !wireframe;
-        glPolygonMode(GL_FRONT_AND_BACK, wireframe ? GL_LINE : GL_FILL);
+        glh::state().polygon_mode(wireframe ? GL_LINE : GL_FILL);
     }
 
     if (key == GLFW_KEY_RIGHT && action == GLFW_PRESS) {
@@ -114,4 +117,12 @@ void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, in
     if (key == GLFW_KEY_LEFT && action == GLFW_PRESS) {
         idx = idx == 0 ? shape_count - 1 : idx - 1;
     }
+
+    if (key == GLFW_KEY_UP && action != GLFW_RELEASE) {
+        zoom = std::min(zoom * 1.25f, 64.0f);
+    }
+
+    if (key == GLFW_KEY_DOWN && action != GLFW_RELEASE) {
+        zoom = std::max(zoom / 1.25f, 1.0f / 64.0f);
+    }
 }
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include <GLFW/glfw3.h>
 
 #include <glhelper/glhelper.hpp>
+#include <glhelper/polyline.hpp>
 
 void glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 
@@ -29,35 +30,26 @@ int main() {
     glfwSetFramebufferSizeCallback(window, glh::glfw_frambuffer_size_callback_square);
     glfwSetKeyCallback(window, glfw_key_callback);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&glh::shader::basic_vertex, GL_VERTEX_SHADER),
-        glh::compile_shader(&glh::shader::basic_fragment, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
+    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
 
-    // geometry
-    std::vector<GLfloat> spiral = glh::shapes::make_spiral(0.75f, 3);
-    GLuint vao = glh::create_vao(spiral);
-    glBindVertexArray(vao);
+    {
+        // geometry, the spiral is extruded on the GPU since core profiles cap glLineWidth at 1
+        // and released at the end of this scope, while the context still exists
+        glh::polyline spiral;
+        spiral.set_points(glh::shapes::make_spiral(0.75f, 3));
+        spiral.set_width(2.0f);
 
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
-    glLineWidth(2);
+        // main loop
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
 
-    // main loop
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
+            spiral.draw();
 
-        glDrawArrays(GL_LINE_STRIP, 0, spiral.size() / 2);
-        
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
-    // clean up
-    glDeleteVertexArrays(1, &vao);
-    glDeleteProgram(shader_program);
-
     glfwTerminate();
 
     return 0;
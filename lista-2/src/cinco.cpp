@@ -4,9 +4,10 @@
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
 
 #include <glhelper/glhelper.hpp>
+#include <glhelper/instancing.hpp>
+#include <glhelper/uniform_buffer.hpp>
 
 #include <shaders.hpp>
 
@@ -27,47 +28,37 @@ int main() {
     // viewport
     glh::glfw_frambuffer_size_callback_square(window, glh::DEFAULT_WIDTH, glh::DEFAULT_HEIGHT);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&shaders::vertex, GL_VERTEX_SHADER),
-        glh::compile_shader(&shaders::fragment, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
-
-    // geometry
-    glh::shape triangle1 = glh::shapes::make_triangle(0.25f, -0.5, -0.5);
-    glh::shape triangle2 = glh::shapes::make_triangle(0.25f, -0.5,  0.5);
-    glh::shape triangle3 = glh::shapes::make_triangle(0.25f,  0.5,  0.5);
-    glh::shape triangle4 = glh::shapes::make_triangle(0.25f,  0.5, -0.5);
-
-    GLuint vao1 = glh::create_vao(triangle1);
-    GLuint vao2 = glh::create_vao(triangle2);
-    GLuint vao3 = glh::create_vao(triangle3);
-    GLuint vao4 = glh::create_vao(triangle4);
-
-    // projection
-    glm::mat4 projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f);
-    glUniformMatrix4fv(glGetUniformLocation(shader_program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
-
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        glBindVertexArray(vao1);
-        glDrawElements(GL_TRIANGLES, triangle1.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-
-        glBindVertexArray(vao2);
-        glDrawElements(GL_TRIANGLES, triangle2.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-
-        glBindVertexArray(vao3);
-        glDrawElements(GL_TRIANGLES, triangle3.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-
-        glBindVertexArray(vao4);
-        glDrawElements(GL_TRIANGLES, triangle4.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
-        
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    // GL objects are released at the end of this scope, while the context still exists
+    {
+        // shader program
+        glh::program_handle shader_program(glh::create_shader_program({
+            glh::compile_shader(&glh::shader::instanced_vertex, GL_VERTEX_SHADER),
+            glh::compile_shader(&shaders::fragment, GL_FRAGMENT_SHADER)
+        }));
+        glh::state().use_program(shader_program);
+
+        // geometry, one triangle drawn once per quadrant
+        glh::instanced_mesh triangles(glh::shapes::make_triangle(0.25f), 4);
+        triangles.add(glh::instances::make_instance(-0.5f, -0.5f));
+        triangles.add(glh::instances::make_instance(-0.5f,  0.5f));
+        triangles.add(glh::instances::make_instance( 0.5f,  0.5f));
+        triangles.add(glh::instances::make_instance( 0.5f, -0.5f));
+
+        // projection, shared with every program through the frame block
+        glh::frame_uniforms frame;
+        frame.set_projection(glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f));
+        frame.update();
+
+        glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
+
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            triangles.draw();
+
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
     glfwTerminate();
@@ -7,10 +7,15 @@ const GLchar* const vertex = R"(
 
     layout (location = 0) in vec2 pos;
 
-    uniform mat4 projection;
+    // filled by glh::frame_uniforms
+    layout (std140) uniform frame {
+        mat4 projection;
+        mat4 view;
+        float time;
+    };
 
     void main() {
-        gl_Position = projection * vec4(pos.xy, 0.0f, 1.0f);
+        gl_Position = projection * view * vec4(pos.xy, 0.0f, 1.0f);
     }
 )";
 
@@ -7,6 +7,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include <glhelper/glhelper.hpp>
+#include <glhelper/uniform_buffer.hpp>
 
 #include <shaders.hpp>
 
@@ -27,31 +28,34 @@ int main() {
     // viewport
     glh::glfw_frambuffer_size_callback_square(window, glh::DEFAULT_WIDTH, glh::DEFAULT_HEIGHT);
 
-    // shader program
-    GLuint shader_program = glh::create_shader_program({
-        glh::compile_shader(&shaders::vertex, GL_VERTEX_SHADER),
-        glh::compile_shader(&shaders::fragment, GL_FRAGMENT_SHADER)
-    });
-    glUseProgram(shader_program);
+    // GL objects are released at the end of this scope, while the context still exists
+    {
+        // shader program
+        glh::program_handle shader_program(glh::create_shader_program({
+            glh::compile_shader(&shaders::vertex, GL_VERTEX_SHADER),
+            glh::compile_shader(&shaders::fragment, GL_FRAGMENT_SHADER)
+        }));
+        glh::state().use_program(shader_program);
 
-    // geometry
-    glh::shape triangle = glh::shapes::make_triangle(360.0f, 640.0f, 360.0f);
-    GLuint vao = glh::create_vao(triangle);
+        // geometry
+        glh::shape triangle = glh::shapes::make_triangle(360.0f, 640.0f, 360.0f);
+        glh::mesh mesh = glh::create_mesh(triangle);
 
-    // projection
-    glm::mat4 projection = glm::ortho(0.0f, (GLfloat) glh::DEFAULT_WIDTH, 0.0f, (GLfloat) glh::DEFAULT_HEIGHT);
-    glUniformMatrix4fv(glGetUniformLocation(shader_program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        // projection, shared with every program through the frame block
+        glh::frame_uniforms frame;
+        frame.set_projection(glm::ortho(0.0f, (GLfloat) glh::DEFAULT_WIDTH, 0.0f, (GLfloat) glh::DEFAULT_HEIGHT));
+        frame.update();
 
-    glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
+        glClearColor(0.69f, 0.69f, 0.69f, 1.0f);
 
-    while (!glfwWindowShouldClose(window)) {
-        glClear(GL_COLOR_BUFFER_BIT);
+        while (!glfwWindowShouldClose(window)) {
+            glClear(GL_COLOR_BUFFER_BIT);
 
-        glBindVertexArray(vao);
-        glDrawElements(GL_TRIANGLES, triangle.indices.size(), GL_UNSIGNED_INT, (GLvoid*) 0);
+            glh::draw(mesh);
         
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+            glfwSwapBuffers(window);
+            glfwPollEvents();
+        }
     }
 
     glfwTerminate();